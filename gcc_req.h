@@ -25,7 +25,7 @@
 #if __MESC__
 typedef void FUNCTION;
 #else
-typedef struct cell* (FUNCTION)(struct cell *);
+typedef struct cell* (FUNCTION)();
 #endif
 
 typedef long SCM;
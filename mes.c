@@ -24,6 +24,7 @@
 /* globals used in REPL */
 char* message;
 int DISABLE_MACRO_EXPANSION;
+int load_depth;
 
 /* Prototypes */
 FILE* open_file(char* name, char* mode);
@@ -35,9 +36,11 @@ struct cell* make_file(FILE* a, char* name);
 struct cell* parse(char* program, int size);
 struct cell* pop_cell();
 void eval();
+void garbage_collect_in_place();
 void garbage_init();
 void init_sl3();
 void push_cell(struct cell* a);
+void request_seal();
 void reset_block(char* a);
 void writeobj(struct cell* output_file, struct cell* op, int write_p);
 
@@ -95,11 +98,15 @@ struct cell* load_file(char* s)
 
 	push_cell(__c_stdin);
 	__c_stdin = make_file(f, s);
+	load_depth = load_depth + 1;
 	while(!Reached_EOF)
 	{
-		garbage_collect();
+		/* Only at the top level is nothing but the ROOTs holding on to cells */
+		if(1 == load_depth) garbage_collect();
+		else garbage_collect_in_place();
 		Reached_EOF = REPL();
 	}
+	load_depth = load_depth - 1;
 	__c_stdin = pop_cell();
 	return cell_t;
 }
@@ -112,6 +119,7 @@ int main(int argc, char **argv, char** envp)
 	__argv = argv;
 	__argc = argc;
 	stack_pointer = 0;
+	load_depth = 0;
 
 	arena = numerate_string(env_lookup("MES_ARENA", envp));
 	if(0 == arena) arena = 1;
@@ -129,15 +137,36 @@ int main(int argc, char **argv, char** envp)
 
 	GC_SAFETY = numerate_string(env_lookup("MES_SAFETY", envp));
 
+	/* Size of the nursery in cells, 0 disables generational collection */
+	GC_NURSERY = numerate_string(env_lookup("MES_NURSERY", envp));
+
+	/* Write a line to stderr for every garbage collection */
+	GC_TRACE = numerate_string(env_lookup("MES_GC_TRACE", envp));
+
+	/* Percentage of runtime garbage collection may take, 0 keeps MES_SAFETY in charge */
+	GC_OVERHEAD = numerate_string(env_lookup("MES_GC_OVERHEAD", envp));
+
+	/* Gray cells marked per allocation, 0 marks everything at once */
+	GC_STEP = numerate_string(env_lookup("MES_GC_STEP", envp));
+
+	/* Threads to mark big pools with, 0 or 1 marks on this one */
+	GC_THREADS = numerate_string(env_lookup("MES_GC_THREADS", envp));
+
+	/* Show what is filling up the heap before giving up on running out of cells */
+	GC_HEAP_DUMP = numerate_string(env_lookup("MES_HEAP_DUMP", envp));
+
+	/* Collect on every Nth allocation and check the heap after every collection, 0 disables */
+	GC_STRESS = numerate_string(env_lookup("MES_GC_STRESS", envp));
+
 	MAX_STACK = numerate_string(env_lookup("MES_STACK", envp));
 	if(0 == MAX_STACK) MAX_STACK = 100000;
 
 	/* Our most important initializations */
 	memory_block = calloc(MAX_TOKEN + 8, sizeof(char));
 	message = calloc(MAX_STRING + 8, sizeof(char));
+	g_stack = calloc(MAX_STACK, sizeof(struct cell*));
 	garbage_init();
 	init_sl3();
-	g_stack = calloc(MAX_STACK, sizeof(struct cell*));
 
 	/* Initialization: stdin, stdout and stderr */
 	__c_stdin = make_file(stdin, "/dev/stdin");
@@ -157,6 +186,8 @@ int main(int argc, char **argv, char** envp)
 			else if(match(argv[i], "--boot"))
 			{
 				load_file(argv[i + 1]);
+				/* Whatever it left behind is here to stay */
+				request_seal();
 				i = i + 2;
 			}
 			else if(match(argv[i], "-f") || match(argv[i], "--file"))
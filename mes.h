@@ -54,6 +54,38 @@
 //CONSTANT EOF_object 1024
 #define EOF_object 1024
 
+/* The special forms, whose SYM holds one of these in CDR */
+//CONSTANT SYNTAX_IF 1
+#define SYNTAX_IF 1
+//CONSTANT SYNTAX_COND 2
+#define SYNTAX_COND 2
+//CONSTANT SYNTAX_LET 3
+#define SYNTAX_LET 3
+//CONSTANT SYNTAX_BEGIN 4
+#define SYNTAX_BEGIN 4
+//CONSTANT SYNTAX_DEFINE 5
+#define SYNTAX_DEFINE 5
+//CONSTANT SYNTAX_SETB 6
+#define SYNTAX_SETB 6
+//CONSTANT SYNTAX_LAMBDA 7
+#define SYNTAX_LAMBDA 7
+//CONSTANT SYNTAX_QUOTE 8
+#define SYNTAX_QUOTE 8
+//CONSTANT SYNTAX_AND 9
+#define SYNTAX_AND 9
+//CONSTANT SYNTAX_OR 10
+#define SYNTAX_OR 10
+//CONSTANT SYNTAX_WHEN 11
+#define SYNTAX_WHEN 11
+//CONSTANT SYNTAX_CASE 12
+#define SYNTAX_CASE 12
+//CONSTANT SYNTAX_WHILE 13
+#define SYNTAX_WHILE 13
+//CONSTANT SYNTAX_QUASIQUOTE 14
+#define SYNTAX_QUASIQUOTE 14
+//CONSTANT SYNTAX_MACRO 15
+#define SYNTAX_MACRO 15
+
 // CONSTANT FALSE 0
 #define FALSE 0
 // CONSTANT TRUE 1
@@ -75,6 +107,7 @@ struct cell
 		struct cell* env;
 		FILE* file;
 		int length;
+		FUNCTION* fixed;
 	};
 };
 
@@ -126,7 +159,15 @@ unsigned left_to_take;
 unsigned arena;
 unsigned max_arena;
 unsigned GC_SAFETY;
+unsigned GC_NURSERY;
+int GC_TRACE;
+int GC_OVERHEAD;
+unsigned GC_STEP;
+unsigned GC_THREADS;
+int GC_HEAP_DUMP;
+unsigned GC_STRESS;
 void garbage_collect();
+void gc_write_barrier(struct cell* c);
 
 /* Lisp Macine */
 struct cell* R0;
@@ -134,10 +175,13 @@ struct cell* R1;
 struct cell* R2;
 struct cell* R3;
 struct cell* R4;
+struct cell* token_stack;
 struct cell* all_symbols;
 struct cell* g_env;
+struct cell* g_symbols_env;
 struct cell** g_stack;
 int stack_pointer;
+SCM g_applications;
 unsigned MAX_STRING;
 unsigned MAX_TOKEN;
 int MAX_STACK;
@@ -35,11 +35,9 @@ struct cell* vector_equal(struct cell* a, struct cell* b);
 
 
 /*** Primitives ***/
-struct cell* nullp(struct cell* args)
+struct cell* nullp(struct cell* a)
 {
-	require(nil != args, "null? requires arguments\n");
-	require(nil == args->cdr, "null? recieved too many arguments\n");
-	if(nil == args->car) return cell_t;
+	if(nil == a) return cell_t;
 	return cell_f;
 }
 
@@ -52,11 +50,9 @@ struct cell* builtin_booleanp(struct cell* args)
 	return cell_f;
 }
 
-struct cell* pairp(struct cell* args)
+struct cell* pairp(struct cell* a)
 {
-	require(nil != args, "pair? requires arguments\n");
-	require(nil == args->cdr, "pair? recieved too many arguments\n");
-	if(CONS == args->car->type) return cell_t;
+	if(CONS == a->type) return cell_t;
 	return cell_f;
 }
 
@@ -145,6 +141,13 @@ struct cell* builtin_sum(struct cell* args)
 	return make_int(sum);
 }
 
+struct cell* builtin_sum2(struct cell* a, struct cell* b)
+{
+	require(INT == a->type, "builtin_sum require integers\n");
+	require(INT == b->type, "builtin_sum require integers\n");
+	return make_int(a->value + b->value);
+}
+
 struct cell* builtin_sub(struct cell* args)
 {
 	require(nil != args, "builtin_sub requires arguments\n");
@@ -159,6 +162,13 @@ struct cell* builtin_sub(struct cell* args)
 	return make_int(sum);
 }
 
+struct cell* builtin_sub2(struct cell* a, struct cell* b)
+{
+	require(INT == a->type, "builtin_sub require integers\n");
+	require(INT == b->type, "builtin_sub require integers\n");
+	return make_int(a->value - b->value);
+}
+
 struct cell* builtin_prod(struct cell* args)
 {
 	if(nil == args) make_int(1);
@@ -172,6 +182,13 @@ struct cell* builtin_prod(struct cell* args)
 	return make_int(prod);
 }
 
+struct cell* builtin_prod2(struct cell* a, struct cell* b)
+{
+	require(INT == a->type, "builtin_prod require integers\n");
+	require(INT == b->type, "builtin_prod require integers\n");
+	return make_int(a->value * b->value);
+}
+
 struct cell* builtin_div(struct cell* args)
 {
 	require(nil != args, "builtin_div requires arguments\n");
@@ -292,12 +309,9 @@ struct cell* builtin_lognot(struct cell* args)
 	return make_int(~args->car->value);
 }
 
-struct cell* builtin_not(struct cell* args)
+struct cell* builtin_not(struct cell* a)
 {
-	require(nil != args, "not requires 1 argument\n");
-	require(nil == args->cdr, "not recieved wrong number of arguments\n");
-
-	if(cell_f == args->car) return cell_t;
+	if(cell_f == a) return cell_t;
 	return cell_f;
 }
 
@@ -319,6 +333,14 @@ struct cell* builtin_numgt(struct cell* args)
 	return cell_t;
 }
 
+struct cell* builtin_numgt2(struct cell* a, struct cell* b)
+{
+	require(INT == a->type, "builtin_numgt require integers\n");
+	require(INT == b->type, "builtin_numgt require integers\n");
+	if(a->value > b->value) return cell_t;
+	return cell_f;
+}
+
 struct cell* builtin_numge(struct cell* args)
 {
 	require(nil != args, "builtin_numge requires arguments\n");
@@ -373,6 +395,14 @@ struct cell* builtin_numlt(struct cell* args)
 	return cell_t;
 }
 
+struct cell* builtin_numlt2(struct cell* a, struct cell* b)
+{
+	require(INT == a->type, "builtin_numlt require integers\n");
+	require(INT == b->type, "builtin_numlt require integers\n");
+	if(a->value < b->value) return cell_t;
+	return cell_f;
+}
+
 struct cell* builtin_chareq(struct cell* args)
 {
 	require(nil != args, "char=? requires arguments\n");
@@ -433,6 +463,25 @@ struct cell* builtin_numeq(struct cell* args)
 	return cell_t;
 }
 
+struct cell* builtin_numeq2(struct cell* a, struct cell* b)
+{
+	require(INT == a->type, "= received non-integer\n");
+	require(INT == b->type, "= received non-integer\n");
+	if(a->value == b->value) return cell_t;
+	return cell_f;
+}
+
+struct cell* builtin_eq2(struct cell* a, struct cell* b)
+{
+	if(a == b) return cell_t;
+	else if(a->type != b->type) return cell_f;
+	else if((INT == a->type) || (CHAR == a->type))
+	{
+		if(a->value == b->value) return cell_t;
+	}
+	return cell_f;
+}
+
 struct cell* builtin_eq(struct cell* args)
 {
 	if(nil == args) return cell_t;
@@ -440,21 +489,7 @@ struct cell* builtin_eq(struct cell* args)
 	struct cell* temp = args->car;
 	for(args = args->cdr; nil != args; args = args->cdr)
 	{
-		if(temp == args->car) continue;
-		else if(temp->type != args->car->type) return cell_f;
-		else if((INT == temp->type) || (CHAR == temp->type))
-		{
-			if(temp->value != args->car->value) return cell_f;
-		}
-		else if(STRING == temp->type)
-		{
-			if(temp != args->car) return cell_f;
-		}
-		else if(CONS == temp->type)
-		{
-			if(temp != args->car) return cell_f;
-		}
-		else return cell_f;
+		if(cell_f == builtin_eq2(temp, args->car)) return cell_f;
 	}
 
 	return cell_t;
@@ -596,46 +631,35 @@ struct cell* builtin_halt(struct cell* args)
 	exit(args->car->value);
 }
 
-struct cell* builtin_cons(struct cell* args)
+struct cell* builtin_cons(struct cell* a, struct cell* b)
 {
-	require(nil != args, "cons requires arguments\n");
-	require(nil != args->cdr, "cons requires 2 arguments\n");
-	require(nil == args->cdr->cdr, "cons recieved too many arguments\n");
-	return make_cons(args->car, args->cdr->car);
+	return make_cons(a, b);
 }
 
-struct cell* builtin_car(struct cell* args)
+struct cell* builtin_car(struct cell* a)
 {
-	require(nil != args, "car requires arguments\n");
-	require(CONS == args->car->type, "car expects a pair\n");
-	require(nil == args->cdr, "car expects only a single argument\n");
-	return args->car->car;
+	require(CONS == a->type, "car expects a pair\n");
+	return a->car;
 }
 
-struct cell* builtin_cdr(struct cell* args)
+struct cell* builtin_cdr(struct cell* a)
 {
-	require(nil != args, "cdr requires arguments\n");
-	require(CONS == args->car->type, "cdr expects a pair\n");
-	require(nil == args->cdr, "cdr expects only a single argument\n");
-	return args->car->cdr;
+	require(CONS == a->type, "cdr expects a pair\n");
+	return a->cdr;
 }
 
-struct cell* builtin_setcar(struct cell* args)
+struct cell* builtin_setcar(struct cell* a, struct cell* b)
 {
-	require(nil != args, "set-car! requires arguments\n");
-	require(CONS == args->car->type, "set-car! requires a mutable pair\n");
-	require(nil != args->cdr, "set-car! requires something to set car to\n");
-	args->car->car = args->cdr->car;
-	require(nil == args->cdr->cdr, "set-car! received too many arguements\n");
+	require(CONS == a->type, "set-car! requires a mutable pair\n");
+	a->car = b;
+	gc_write_barrier(a);
 	return cell_unspecified;
 }
 
-struct cell* builtin_setcdr(struct cell* args)
+struct cell* builtin_setcdr(struct cell* a, struct cell* b)
 {
-	require(nil != args, "set-cdr! requires arguments\n");
-	require(CONS == args->car->type, "set-cdr! requires a mutable pair\n");
-	require(nil != args->cdr, "set-cdr! requires something to set cdr to\n");
-	args->car->cdr = args->cdr->car;
-	require(nil == args->cdr->cdr, "set-cdr! received too many arguements\n");
+	require(CONS == a->type, "set-cdr! requires a mutable pair\n");
+	a->cdr = b;
+	gc_write_barrier(a);
 	return cell_unspecified;
 }
@@ -23,12 +23,85 @@
 /* Imported functions */
 struct cell* list_to_vector(struct cell* i);
 void expand_pool();
+void garbage_collect_in_place();
+int cell_marked(struct cell* c);
+void gc_mark_step();
+void finish_incremental();
+void allocate_gray(struct cell* c);
+void keep_small_cells();
+void heap_dump();
+void keep_cards();
+void gray_cell(struct cell* c);
+void gc_stress();
+void verify_heap(int compacted);
+int gc_prefer_growth();
+int commit_memory(void* base, size_t offset, size_t size);
+void* reserve_memory(size_t size);
+int mark_in_parallel(struct cell** roots, unsigned count, unsigned threads);
+SCM clock_microseconds();
+void forward_symbol_table();
+struct cell* intern(char* name);
+struct cell* make_int(int a);
+struct cell* make_sym(char* name);
+struct cell* pop_cell();
+struct cell* pop_cons();
+void push_cell(struct cell* a);
 
 
 /* Deal with the fact GCC converts the 1 to the size of the structs being iterated over */
 #define CELL_SIZE 1
 //CONSTANT CELL_SIZE sizeof(struct cell)
 
+/* How many cells the lazy sweeper looks at in one go */
+#define SWEEP_BLOCK 256
+//CONSTANT SWEEP_BLOCK 256
+
+/* Keep the marks in a side bitmap rather than in the TYPE of the cells, 0 for the old way */
+#define GC_MARK_BITMAP 1
+//CONSTANT GC_MARK_BITMAP 1
+
+/* The bytes in front of every string in the string heap and its initial size */
+#define STRING_HEADER 12
+//CONSTANT STRING_HEADER 12
+#define STRING_HEAP_SIZE 1048576
+//CONSTANT STRING_HEAP_SIZE 1048576
+
+/* The pool is made usable in steps of this many bytes */
+#define COMMIT_CHUNK 1048576
+//CONSTANT COMMIT_CHUNK 1048576
+
+/* Below this many cells the adaptive policy always grows the pool rather than collecting */
+#define GC_SMALL_POOL 65536
+//CONSTANT GC_SMALL_POOL 65536
+
+/* The adaptive policy never lets fewer cells than this be allocated between collections */
+#define GC_MIN_BUDGET 4096
+//CONSTANT GC_MIN_BUDGET 4096
+
+/* Below this many cells to mark, starting threads costs more than it saves */
+#define GC_PARALLEL_CELLS 65536
+//CONSTANT GC_PARALLEL_CELLS 65536
+
+/* The INTs from -SMALL_INT_BIAS up and every CHAR get a cell of their own to share */
+#define SMALL_INTS 1024
+//CONSTANT SMALL_INTS 1024
+#define SMALL_INT_BIAS 16
+//CONSTANT SMALL_INT_BIAS 16
+#define SMALL_CHARS 256
+//CONSTANT SMALL_CHARS 256
+
+/* How many of the ROOTs keeping the most cells alive MES_HEAP_DUMP lists */
+#define CENSUS_TOP 10
+//CONSTANT CENSUS_TOP 10
+
+/* Every card of the immortal region covers 1 << GC_CARD_SHIFT cells */
+#define GC_CARD_SHIFT 6
+//CONSTANT GC_CARD_SHIFT 6
+
+/* How many cells the mark stack can hold before it first has to grow */
+#define MARK_STACK_SIZE 1024
+//CONSTANT MARK_STACK_SIZE 1024
+
 /****************************************
  * free_cells is a list of all free     *
  * cells. Which by design is ordered    *
@@ -52,453 +125,2392 @@ struct cell* gc_block_start;
 
 
 /****************************************
- * top_allocated, is just a pointer to  *
- * absolute highest non-free cell. This *
- * is to reduce the amount of time      *
- * iterating over free cells when       *
- * engaged in garbage collection.       *
- * Its value can only go up on          *
- * allocations and only go down with    *
- * relocations during compaction.       *
+ * top_allocated, is just a pointer to  *
+ * absolute highest non-free cell. This *
+ * is to reduce the amount of time      *
+ * iterating over free cells when       *
+ * engaged in garbage collection.       *
+ * Its value can only go up on          *
+ * allocations and only go down with    *
+ * relocations during compaction.       *
+ ****************************************/
+struct cell* top_allocated;
+
+
+/****************************************
+ * sweep_cursor is the next cell the    *
+ * lazy sweeper is going to look at.    *
+ * Every cell below it has already been *
+ * swept since the last collection and  *
+ * every cell at or above it still has  *
+ * to be checked before it can be given *
+ * out. Reset to gc_block_start at the  *
+ * end of every mark phase.             *
+ ****************************************/
+struct cell* sweep_cursor;
+
+
+/****************************************
+ * The whole of the pool (max_arena     *
+ * cells) is reserved up front but only *
+ * the first gc_committed bytes of it   *
+ * are actually usable memory.          *
+ ****************************************/
+size_t gc_reserved;
+size_t gc_committed;
+
+
+/****************************************
+ * The side tables used by compaction,  *
+ * gc_live_bits has one bit per cell    *
+ * set for every cell that survived and *
+ * gc_live_before holds for every byte  *
+ * of gc_live_bits the number of cells  *
+ * that survived below it. Together     *
+ * they give the forwarding address of  *
+ * any surviving cell without having to *
+ * store it in the cell itself.         *
+ * gc_bit_count is simply the number of *
+ * bits set in every possible byte.     *
+ ****************************************/
+char* gc_live_bits;
+int* gc_live_before;
+char* gc_bit_count;
+
+
+/****************************************
+ * Generational collection, which is    *
+ * only used if MES_NURSERY is set.     *
+ * Every cell at or below               *
+ * gc_old_boundary is old and every     *
+ * cell above it is in the nursery.     *
+ * As compaction keeps cells in order,  *
+ * promoting the nursery is just moving *
+ * the boundary up to top_allocated.    *
+ * NULL means there is no old           *
+ * generation (yet).                    *
+ *                                      *
+ * gc_remembered has one bit per old    *
+ * cell that has been changed since the *
+ * last collection, as only those can   *
+ * point into the nursery.              *
+ * gc_old_after_major is how many cells *
+ * were old after the last collection   *
+ * of everything.                       *
+ ****************************************/
+struct cell* gc_old_boundary;
+char* gc_remembered;
+unsigned gc_old_after_major;
+
+
+/****************************************
+ * The immortal region, every cell at   *
+ * or below gc_immortal. What init_sl3  *
+ * and the boot file create is live for *
+ * as long as we run, so once sealed    *
+ * (at the next safe point after        *
+ * gc_seal_requested is set) those      *
+ * cells are never marked, swept or     *
+ * moved again. NULL means nothing has  *
+ * been sealed (yet).                   *
+ *                                      *
+ * gc_cards has one byte per card of    *
+ * the immortal region, which is set    *
+ * when gc_write_barrier sees one of    *
+ * its cells changed. Only the cells on *
+ * those cards can point to mortal      *
+ * cells and thus have to be looked at  *
+ * by every collection.                 *
+ ****************************************/
+struct cell* gc_immortal;
+char* gc_cards;
+int gc_seal_requested;
+
+
+/****************************************
+ * With MES_GC_STRESS set, every        *
+ * GC_STRESS-th call to pop_cons        *
+ * collects and every collection checks *
+ * the heap, so a missing ROOT shows up *
+ * right where it is missed.            *
+ * gc_stress_count is how many cells    *
+ * have been handed out since the last  *
+ * stress collection.                   *
+ ****************************************/
+unsigned gc_stress_count;
+
+
+/****************************************
+ * With GC_MARK_BITMAP, gc_mark_bits    *
+ * holds one bit per cell in the pool   *
+ * which is set once the mark phase     *
+ * finds the cell reachable. Thus a     *
+ * collection only writes to the cells  *
+ * it actually keeps (and moves) rather *
+ * than to every page of the pool.      *
+ ****************************************/
+char* gc_mark_bits;
+
+
+/****************************************
+ * The string heap holds the bytes of   *
+ * strings, symbols and the like, which *
+ * are handed out by pop_string one     *
+ * after another. Every string is       *
+ * preceded by a STRING_HEADER holding  *
+ * its size, whether it is live and     *
+ * where it is going to be moved to,    *
+ * so the string heap can be compacted  *
+ * the same way as the cells.           *
+ * gc_string_pressure is set once it is *
+ * getting full, so that the next safe  *
+ * point collects everything.           *
+ ****************************************/
+char* gc_string_start;
+unsigned gc_string_used;
+unsigned gc_string_size;
+int gc_string_pressure;
+
+
+/****************************************
+ * The mark stack holds the cells the   *
+ * mark phase still has to walk, so     *
+ * that marking never recurses in C no  *
+ * matter how deeply nested the cells   *
+ * are. It doubles whenever it fills up *
+ * and gc_mark_stack_high records the   *
+ * deepest it has ever been.            *
+ ****************************************/
+struct cell** gc_mark_stack;
+unsigned gc_mark_stack_size;
+unsigned gc_mark_stack_pointer;
+unsigned gc_mark_stack_high;
+
+
+/****************************************
+ * With MES_GC_STEP set, marking is     *
+ * spread over the allocations rather   *
+ * than done all at once. gc_marking is *
+ * TRUE while such an incremental mark  *
+ * is in progress; during which the     *
+ * mark stack holds the gray cells:     *
+ * those found reachable whose CAR, CDR *
+ * and ENV still have to be looked at.  *
+ ****************************************/
+int gc_marking;
+
+
+/****************************************
+ * With MES_GC_THREADS set, the ROOTs   *
+ * are gathered in gc_roots so they can *
+ * be shared out between the threads of *
+ * the parallel marker.                 *
+ ****************************************/
+struct cell** gc_roots;
+
+
+/****************************************
+ * Where the compaction in progress     *
+ * starts, nothing below it moves.      *
+ ****************************************/
+struct cell* gc_compact_from;
+
+
+/****************************************
+ * live_cells is the number of cells    *
+ * the last mark phase found reachable  *
+ * which lets us know how many cells    *
+ * are left_to_take without having to   *
+ * sweep the whole pool first.          *
+ ****************************************/
+unsigned live_cells;
+
+
+/****************************************
+ * gc_small_cells holds a cell for each *
+ * of the SMALL_INTS most common INTs   *
+ * followed by one for every CHAR, all  *
+ * created when the pool is. make_int   *
+ * and make_char hand these out rather  *
+ * than allocating, which is fine as    *
+ * nothing ever changes the VALUE of an *
+ * INT or CHAR once it is made. They    *
+ * are always live and as they sit at   *
+ * the bottom of the pool compaction    *
+ * never has to move them either.       *
+ ****************************************/
+struct cell** gc_small_cells;
+
+
+/****************************************
+ * A census of the heap, for            *
+ * core:heap-histogram and              *
+ * MES_HEAP_DUMP. census_seen has a bit *
+ * for every cell found so far and      *
+ * census_counts the number found of    *
+ * each TYPE. census_top_* are the      *
+ * ROOTs that the most cells were first *
+ * found from, most first.              *
+ ****************************************/
+char* census_seen;
+unsigned* census_counts;
+unsigned* census_top_cells;
+char** census_top_name;
+int* census_top_index;
+
+
+/****************************************
+ * Running totals of what the garbage   *
+ * collector has been up to, for        *
+ * core:gc-stats and MES_GC_TRACE.      *
+ * Pause times are in microseconds and  *
+ * gc_top_high is the most cells ever   *
+ * in use below top_allocated.          *
+ * Together with g_applications,        *
+ * gc_cells_allocated tells how many    *
+ * cells an average call costs.         *
+ ****************************************/
+unsigned gc_collections;
+SCM gc_pause_total;
+SCM gc_pause_max;
+SCM gc_cells_marked;
+SCM gc_cells_reclaimed;
+SCM gc_cells_moved;
+SCM gc_cells_allocated;
+unsigned gc_expansions;
+unsigned gc_top_high;
+
+
+/****************************************
+ * What a collection in progress needs  *
+ * to remember for gc_end.              *
+ ****************************************/
+SCM gc_started;
+unsigned gc_in_use;
+SCM gc_moved_before;
+
+
+/****************************************
+ * The adaptive policy used when        *
+ * MES_GC_OVERHEAD is set. gc_budget is *
+ * how many cells may be allocated      *
+ * between collections, which gives us  *
+ * gc_trigger: the left_to_take at      *
+ * which the next one happens. The      *
+ * survival rate and overhead (both as  *
+ * percentages) of the last collection  *
+ * decide between growing and           *
+ * collecting.                          *
+ ****************************************/
+unsigned gc_budget;
+unsigned gc_trigger;
+int gc_last_survival;
+int gc_last_overhead;
+SCM gc_last_end;
+
+
+/****************************************
+ * The Sweep part of the Mark and sweep *
+ * garbage collection.                  *
+ *                                      *
+ *  *One of few performance critical*   *
+ *                                      *
+ * Rather than sweeping the whole pool  *
+ * right after marking, pop_cons calls  *
+ * this whenever it runs dry. It sweeps *
+ * the next SWEEP_BLOCK cells and hangs *
+ * the free ones onto free_cells. As    *
+ * the cursor only ever moves up, the   *
+ * free list is built from lowest to    *
+ * highest address without having to    *
+ * search for the insertion point.      *
+ *                                      *
+ * Cells above top_allocated have not   *
+ * been handed out since they were last *
+ * freed, so whatever is left in them   *
+ * is ignored; which is also why the    *
+ * pool never needs to be prethreaded.  *
+ *                                      *
+ * While an incremental mark is in      *
+ * progress the mark bits are not done  *
+ * yet, so only cells that are known to *
+ * be FREE are taken; whatever garbage  *
+ * is skipped is found again once the   *
+ * mark is finished.                    *
+ *                                      *
+ * Returns FALSE once the cursor has    *
+ * run off the top of the pool.         *
+ ****************************************/
+int sweep_block()
+{
+	struct cell* limit = gc_block_start + (arena * CELL_SIZE);
+	if(sweep_cursor > limit) return FALSE;
+
+	struct cell* end = sweep_cursor + (SWEEP_BLOCK * CELL_SIZE);
+	if(end > limit) end = limit + CELL_SIZE;
+
+	struct cell* tail = NULL;
+	struct cell* i;
+	for(i = sweep_cursor; i < end; i = i + CELL_SIZE)
+	{
+		if((i > top_allocated) || (FREE == i->type) || (!gc_marking && cell_marked(i)))
+		{
+			i->type = FREE;
+			i->car = NULL;
+			i->cdr = NULL;
+			i->env = NULL;
+
+			if(NULL == tail) free_cells = i;
+			else tail->cdr = i;
+			tail = i;
+		}
+	}
+	sweep_cursor = end;
+	return TRUE;
+}
+
+
+/****************************************
+ * Keep sweeping until we either have   *
+ * free cells to hand out or we have    *
+ * swept all the way to the top of the  *
+ * pool.                                *
+ ****************************************/
+void sweep_lazily()
+{
+	while(NULL == free_cells)
+	{
+		if(!sweep_block()) return;
+	}
+}
+
+
+/****************************************
+ * pop_cons for the constructors, which *
+ * keeps the cells they are about to    *
+ * store in the new cell safe should    *
+ * pop_cons collect. Which it can not   *
+ * while there are free cells left to   *
+ * hand out, so only then do we bother. *
+ ****************************************/
+struct cell* pop_cons_holding(struct cell* a, struct cell* b, struct cell* env)
+{
+	if((0 == GC_STRESS) && (NULL != free_cells)) return pop_cons();
+	if((0 == GC_STRESS) && (sweep_cursor > top_allocated) && (sweep_cursor <= (gc_block_start + (arena * CELL_SIZE)))) return pop_cons();
+
+	push_cell(a);
+	push_cell(b);
+	push_cell(env);
+	struct cell* c = pop_cons();
+	pop_cell();
+	pop_cell();
+	pop_cell();
+	return c;
+}
+
+
+/****************************************
+ * Once the sweeper has made it past    *
+ * top_allocated, which is right away   *
+ * after a compaction, every cell from  *
+ * the cursor up is free. So rather     *
+ * than sweeping them into free_cells   *
+ * one SWEEP_BLOCK at a time, we simply *
+ * hand out the cell at the cursor and  *
+ * move it up. Returns NULL when there  *
+ * are free_cells to use first or the   *
+ * cursor is not above top_allocated.   *
+ ****************************************/
+struct cell* bump_cell()
+{
+	if(NULL != free_cells) return NULL;
+	if(sweep_cursor <= top_allocated) return NULL;
+	if(sweep_cursor > (gc_block_start + (arena * CELL_SIZE))) return NULL;
+
+	struct cell* i = sweep_cursor;
+	sweep_cursor = sweep_cursor + CELL_SIZE;
+	i->type = FREE;
+	i->car = NULL;
+	i->cdr = NULL;
+	i->env = NULL;
+	return i;
+}
+
+
+/****************************************
+ * A centralized method of allocating   *
+ * the free cells to calling functions  *
+ *                                      *
+ * An ideal place to catch memory       *
+ * exhustion errors and engage in       *
+ * active garbage collection.           *
+ *                                      *
+ * The returned cell should have ALL    *
+ * fields equal to NULL.                *
+ ****************************************/
+struct cell* pop_cons()
+{
+	if(0 != GC_STRESS) gc_stress();
+	if(0 != GC_STEP) gc_mark_step();
+
+	/* The common case */
+	struct cell* i = bump_cell();
+	if(NULL == i)
+	{
+		if(NULL == free_cells) sweep_lazily();
+		if(NULL == free_cells)
+		{
+			/* We have to get free cells if possible */
+			if(gc_prefer_growth()) expand_pool();
+			garbage_collect_in_place();
+			sweep_lazily();
+			if(NULL == free_cells)
+			{
+				expand_pool();
+				sweep_lazily();
+			}
+			if((NULL == free_cells) && GC_HEAP_DUMP) heap_dump();
+			require(NULL != free_cells, "OOOPS we ran out of cells\n");
+		}
+		i = free_cells;
+		free_cells = i->cdr;
+		i->cdr = NULL;
+	}
+	left_to_take = left_to_take - 1;
+	gc_cells_allocated = gc_cells_allocated + 1;
+
+	/* See if we need to move up */
+	if(i > top_allocated)
+	{
+		top_allocated = i;
+		if(((i - gc_block_start) / CELL_SIZE) >= gc_top_high) gc_top_high = ((i - gc_block_start) / CELL_SIZE) + 1;
+	}
+
+	if(gc_marking) allocate_gray(i);
+	return i;
+}
+
+
+/****************************************
+ * Is the cell still MARKED, which is   *
+ * to say the mark phase has not found  *
+ * it to be reachable (yet).            *
+ ****************************************/
+int cell_marked(struct cell* c)
+{
+	if(GC_MARK_BITMAP)
+	{
+		unsigned n = (c - gc_block_start) / CELL_SIZE;
+		return (0 == (gc_mark_bits[n >> 3] & (1 << (n & 7))));
+	}
+	return (0 != (c->type & MARKED));
+}
+
+
+/****************************************
+ * The mark phase found the cell to be  *
+ * reachable, so it is to be kept.      *
+ ****************************************/
+void unmark_cell(struct cell* c)
+{
+	if(GC_MARK_BITMAP)
+	{
+		unsigned n = (c - gc_block_start) / CELL_SIZE;
+		gc_mark_bits[n >> 3] = gc_mark_bits[n >> 3] | (1 << (n & 7));
+	}
+	else c->type = c->type & ~MARKED;
+}
+
+
+/****************************************
+ * Set (or clear) the bits for cells    *
+ * LOW up to but not including HIGH in  *
+ * gc_mark_bits, a whole byte at a time *
+ * where possible.                      *
+ ****************************************/
+void set_mark_bits(unsigned low, unsigned high, int value)
+{
+	int byte = 0;
+	if(value) byte = 0xFF;
+
+	while((low < high) && (0 != (low & 7)))
+	{
+		if(value) gc_mark_bits[low >> 3] = gc_mark_bits[low >> 3] | (1 << (low & 7));
+		else gc_mark_bits[low >> 3] = gc_mark_bits[low >> 3] & ~(1 << (low & 7));
+		low = low + 1;
+	}
+
+	while((low + 8) <= high)
+	{
+		gc_mark_bits[low >> 3] = byte;
+		low = low + 8;
+	}
+
+	while(low < high)
+	{
+		if(value) gc_mark_bits[low >> 3] = gc_mark_bits[low >> 3] | (1 << (low & 7));
+		else gc_mark_bits[low >> 3] = gc_mark_bits[low >> 3] & ~(1 << (low & 7));
+		low = low + 1;
+	}
+}
+
+
+/****************************************
+ * The first cell that is not immortal, *
+ * where every collection starts.       *
+ ****************************************/
+struct cell* gc_mortal_start()
+{
+	if(NULL == gc_immortal) return gc_block_start;
+	return gc_immortal + CELL_SIZE;
+}
+
+
+/****************************************
+ * The first half of the mark phase of  *
+ * mark and sweep.                      *
+ *                                      *
+ *  *One of few performance critical*   *
+ *                                      *
+ * With GC_MARK_BITMAP all this has to  *
+ * do is to clear the bits of the cells *
+ * from I up, while setting them for    *
+ * the cells below so they are treated  *
+ * as live; without touching the cells  *
+ * themselves.                          *
+ *                                      *
+ * Otherwise the bottom 2 bits of the   *
+ * TYPE are reserved with the bottom    *
+ * bit explicitly for MARKED. This is   *
+ * to prevent changing of types when    *
+ * marking cells. This is done from low *
+ * to high to allow optimaizations like *
+ * only having to mark cells that are   *
+ * not already free.                    *
+ * You don't want to mark FREE cells so *
+ * That if you wish to later remove the *
+ * counting of free cells at the end    *
+ * you can do so without the fear of    *
+ * double counting.                     *
+ * Everything below where we start is   *
+ * left alone and thus treated as live. *
+ ****************************************/
+void mark_all_cells(struct cell* i)
+{
+	if(GC_MARK_BITMAP)
+	{
+		unsigned from = (i - gc_block_start) / CELL_SIZE;
+		unsigned top = 0;
+		if(NULL != top_allocated) top = ((top_allocated - gc_block_start) / CELL_SIZE) + 1;
+		set_mark_bits(0, from, TRUE);
+		if(from < top) set_mark_bits(from, top, FALSE);
+		return;
+	}
+
+	for(; i <= top_allocated; i = i + CELL_SIZE)
+	{
+		/* if not in the free list */
+		if(i->type != FREE)
+		{
+			/* Mark it */
+			i->type = i->type | MARKED;
+		}
+	}
+}
+
+
+/****************************************
+ * Which fields of a cell point to      *
+ * other cells depends upon its TYPE.   *
+ * CDR is either NULL or a cell for all *
+ * of them.                             *
+ ****************************************/
+int car_is_cell(int type)
+{
+	if(CONS == type) return TRUE;
+	if(RECORD == type) return TRUE;
+	if(LAMBDA == type) return TRUE;
+	if(MACRO == type) return TRUE;
+	return FALSE;
+}
+
+int env_is_cell(int type)
+{
+	if(LAMBDA == type) return TRUE;
+	if(MACRO == type) return TRUE;
+	return FALSE;
+}
+
+
+/****************************************
+ * Save a cell for the mark phase to    *
+ * walk later, growing the mark stack   *
+ * if we have to.                       *
+ ****************************************/
+void push_mark_stack(struct cell* c)
+{
+	if(gc_mark_stack_pointer == gc_mark_stack_size)
+	{
+		struct cell** bigger = calloc(gc_mark_stack_size * 2, sizeof(struct cell*));
+		require(NULL != bigger, "unable to grow the mark stack\n");
+		unsigned i;
+		for(i = 0; i < gc_mark_stack_size; i = i + 1) bigger[i] = gc_mark_stack[i];
+		free(gc_mark_stack);
+		gc_mark_stack = bigger;
+		gc_mark_stack_size = gc_mark_stack_size * 2;
+	}
+
+	gc_mark_stack[gc_mark_stack_pointer] = c;
+	gc_mark_stack_pointer = gc_mark_stack_pointer + 1;
+	if(gc_mark_stack_pointer > gc_mark_stack_high)
+	{
+		gc_mark_stack_high = gc_mark_stack_pointer;
+		if(3 <= mes_debug_level)
+		{
+			file_print("MARK STACK HIGH WATER: ", stderr);
+			file_print(numerate_number(gc_mark_stack_high), stderr);
+			file_print(" cells\n", stderr);
+		}
+	}
+}
+
+
+/****************************************
+ * The second half of the mark phase of *
+ * mark and sweep.                      *
+ *                                      *
+ *  *One of few performance critical*   *
+ *     * CORRECTNESS IS ESSENTIAL *     *
+ *                                      *
+ * Essentially we need to UNMARK all    *
+ * cells which we do not want garbage   *
+ * collected.                           *
+ *                                      *
+ * This function needs to be called on  *
+ * ALL ROOTs if any are missed we are   *
+ * going to lose data and suffer from   *
+ * CORRUPTION which will crash your     *
+ * program in hard to debug ways.       *
+ *                                      *
+ * CARs and ENVs are saved on the mark  *
+ * stack rather than recursed into, so  *
+ * deeply nested trees and long         *
+ * environment chains can not run us    *
+ * out of C stack.                      *
+ ****************************************/
+void unmark_cells(struct cell* i)
+{
+	if(NULL == i) return;
+	push_mark_stack(i);
+
+	while(0 < gc_mark_stack_pointer)
+	{
+		gc_mark_stack_pointer = gc_mark_stack_pointer - 1;
+		i = gc_mark_stack[gc_mark_stack_pointer];
+
+		/* Iteratively walk through cdrs because that path is the most numerous */
+		for(; NULL != i; i = i->cdr)
+		{
+			/* If we hit an unmarked cell it means we already did that tree so STOP */
+			if(!cell_marked(i)) break;
+			unmark_cell(i);
+			live_cells = live_cells + 1;
+
+			/* Deal with TYPE that set CAR to be other cells */
+			if(car_is_cell(i->type))
+			{
+				require(NULL != i->car, "unmark_cells impossible car\n");
+				if(cell_marked(i->car)) push_mark_stack(i->car);
+			}
+
+			/* Deal with the TYPES that set ENV to be other cells */
+			if(env_is_cell(i->type))
+			{
+				require((NULL != i->env), "unmark_cells impossible env\n");
+				if(cell_marked(i->env)) push_mark_stack(i->env);
+			}
+		}
+	}
+}
+
+
+/****************************************
+ * Nearly all of the essential roots    *
+ * are created during evaluation and    *
+ * need to be protected from garbage    *
+ * collection until the evaluation      *
+ * completes. Thus they are pushed unto *
+ * the stack and will be unmarked as    *
+ * efficiently as possible              *
+ *                                      *
+ *     * CORRECTNESS IS ESSENTIAL *     *
+ * never push non-cells onto the stack  *
+ *                                      *
+ * NULL vales are fine but promptly     *
+ * ignored by unmark_cells.             *
+ * The stack pointer always points to   *
+ * the first free cell on the stack.    *
+ ****************************************/
+void unmark_stack()
+{
+	unsigned i = 0;
+	struct cell* s;
+	while(i < stack_pointer)
+	{
+		s = g_stack[i];
+		unmark_cells(s);
+		i = i + 1;
+	}
+}
+
+
+/****************************************
+ * The shared INT and CHAR cells have   *
+ * nothing in them pointing to other    *
+ * cells, so all keeping them takes is  *
+ * setting their bits.                  *
+ ****************************************/
+void keep_small_cells()
+{
+	unsigned i;
+	for(i = 0; i < (SMALL_INTS + SMALL_CHARS); i = i + 1)
+	{
+		if(cell_marked(gc_small_cells[i]))
+		{
+			unmark_cell(gc_small_cells[i]);
+			live_cells = live_cells + 1;
+		}
+	}
+}
+
+
+/****************************************
+ * On a big enough pool, let the        *
+ * platform mark from the ROOTs with    *
+ * MES_GC_THREADS threads. Returns      *
+ * FALSE if it can not, leaving the     *
+ * marking to us.                       *
+ ****************************************/
+int mark_live_cells_in_parallel(struct cell* from)
+{
+	if(2 > GC_THREADS) return FALSE;
+	if(NULL == top_allocated) return FALSE;
+	if(GC_PARALLEL_CELLS > ((top_allocated - from) / CELL_SIZE)) return FALSE;
+
+	unsigned count = 0;
+	gc_roots[0] = g_env;
+	gc_roots[1] = all_symbols;
+	gc_roots[2] = R0;
+	gc_roots[3] = R1;
+	gc_roots[4] = R2;
+	gc_roots[5] = R3;
+	gc_roots[6] = R4;
+	gc_roots[7] = __c_stdin;
+	gc_roots[8] = __c_stdout;
+	gc_roots[9] = __c_stderr;
+	gc_roots[10] = token_stack;
+	gc_roots[11] = g_symbols_env;
+	int i;
+	for(i = 0; i < 12; i = i + 1)
+	{
+		if(NULL != gc_roots[i])
+		{
+			gc_roots[count] = gc_roots[i];
+			count = count + 1;
+		}
+	}
+	for(i = 0; i < stack_pointer; i = i + 1)
+	{
+		if(NULL != g_stack[i])
+		{
+			gc_roots[count] = g_stack[i];
+			count = count + 1;
+		}
+	}
+
+	int marked = mark_in_parallel(gc_roots, count, GC_THREADS);
+	if(0 > marked) return FALSE;
+	live_cells = live_cells + marked;
+	return TRUE;
+}
+
+
+/****************************************
+ * Find all of the cells reachable from *
+ * our ROOTs, leaving everything else   *
+ * above FROM MARKED and counting the   *
+ * live ones. Cells below FROM are      *
+ * simply assumed to be live.           *
+ *                                      *
+ *     * CORRECTNESS IS ESSENTIAL *     *
+ *                                      *
+ * If any ROOTs are missed here the     *
+ * damage will not be fixable.          *
+ ****************************************/
+void mark_live_cells(struct cell* from)
+{
+	/* Any incremental mark in progress is simply abandoned */
+	gc_marking = FALSE;
+	gc_mark_stack_pointer = 0;
+
+	/* Step zero: mark all cells */
+	live_cells = (from - gc_block_start) / CELL_SIZE;
+	mark_all_cells(from);
+
+	/* Step one: unmark cells we want to keep */
+	keep_small_cells();
+	keep_cards();
+	if(mark_live_cells_in_parallel(from)) return;
+	unmark_cells(g_env);
+	unmark_cells(all_symbols);
+	unmark_cells(R0);
+	unmark_cells(R1);
+	unmark_cells(R2);
+	unmark_cells(R3);
+	unmark_cells(R4);
+	unmark_cells(__c_stdin);
+	unmark_cells(__c_stdout);
+	unmark_cells(__c_stderr);
+	unmark_cells(token_stack);
+	unmark_cells(g_symbols_env);
+	unmark_stack();
+}
+
+
+/****************************************
+ * The write barrier, which needs to be *
+ * called on every cell that has one of *
+ * its CAR, CDR or ENV changed after it *
+ * was created. Otherwise a minor       *
+ * collection will not know that an old *
+ * cell now points into the nursery.    *
+ *                                      *
+ * Nor would an incremental mark know   *
+ * that a cell it already looked at now *
+ * points somewhere else, so such cells *
+ * are made gray again.                 *
+ ****************************************/
+void gc_write_barrier(struct cell* c)
+{
+	if(gc_marking && !cell_marked(c)) push_mark_stack(c);
+	if(c < gc_block_start) return;
+	unsigned n = (c - gc_block_start) / CELL_SIZE;
+
+	/* Immortal cells only ever need their card looked at */
+	if(c <= gc_immortal)
+	{
+		gc_cards[n >> GC_CARD_SHIFT] = TRUE;
+		return;
+	}
+
+	/* Also covers there not being an old generation */
+	if(c > gc_old_boundary) return;
+	gc_remembered[n >> 3] = gc_remembered[n >> 3] | (1 << (n & 7));
+}
+
+
+/****************************************
+ * Keep a cell an immortal one points   *
+ * to, by marking it right away or by   *
+ * making it gray should an incremental *
+ * mark be in progress. Returns whether *
+ * it is a mortal cell at all.          *
+ ****************************************/
+int keep_card_cell(struct cell* c)
+{
+	if(NULL == c) return FALSE;
+	if(c <= gc_immortal) return FALSE;
+	if(gc_marking) gray_cell(c);
+	else unmark_cells(c);
+	return TRUE;
+}
+
+
+/****************************************
+ * The cells on the changed cards of    *
+ * the immortal region are ROOTs for    *
+ * every collection. A card none of     *
+ * whose cells point to mortal cells    *
+ * any more is clean again.             *
+ ****************************************/
+void keep_cards()
+{
+	if(NULL == gc_immortal) return;
+
+	unsigned cells = ((gc_immortal - gc_block_start) / CELL_SIZE) + 1;
+	unsigned cards = ((cells - 1) >> GC_CARD_SHIFT) + 1;
+	unsigned card;
+	unsigned n;
+	unsigned high;
+	int mortal;
+	struct cell* i;
+	for(card = 0; card < cards; card = card + 1)
+	{
+		if(gc_cards[card])
+		{
+			mortal = FALSE;
+			n = card << GC_CARD_SHIFT;
+			high = n + (1 << GC_CARD_SHIFT);
+			if(high > cells) high = cells;
+			for(; n < high; n = n + 1)
+			{
+				i = gc_block_start + (n * CELL_SIZE);
+				if(car_is_cell(i->type) && keep_card_cell(i->car)) mortal = TRUE;
+				if(keep_card_cell(i->cdr)) mortal = TRUE;
+				if(env_is_cell(i->type) && keep_card_cell(i->env)) mortal = TRUE;
+			}
+			gc_cards[card] = mortal;
+		}
+	}
+}
+
+
+/****************************************
+ * The remembered old cells are ROOTs   *
+ * for a minor collection, which is all *
+ * we need as the rest of the old cells *
+ * can only point to other old cells.   *
+ ****************************************/
+void unmark_remembered()
+{
+	unsigned bytes = (((gc_old_boundary - gc_block_start) / CELL_SIZE) >> 3) + 1;
+	unsigned n;
+	int bit;
+	struct cell* i;
+	for(n = 0; n < bytes; n = n + 1)
+	{
+		if(0 != gc_remembered[n])
+		{
+			for(bit = 0; bit < 8; bit = bit + 1)
+			{
+				if(0 != (gc_remembered[n] & (1 << bit)))
+				{
+					i = gc_block_start + ((((n << 3) + bit)) * CELL_SIZE);
+					if(car_is_cell(i->type)) unmark_cells(i->car);
+					unmark_cells(i->cdr);
+					if(env_is_cell(i->type)) unmark_cells(i->env);
+				}
+			}
+		}
+	}
+}
+
+
+/****************************************
+ * Forget all of the remembered cells,  *
+ * which we can do after every          *
+ * collection as there is no nursery    *
+ * left for them to point into.         *
+ ****************************************/
+void clear_remembered()
+{
+	if(NULL == gc_old_boundary) return;
+
+	unsigned bytes = (((gc_old_boundary - gc_block_start) / CELL_SIZE) >> 3) + 1;
+	unsigned n;
+	for(n = 0; n < bytes; n = n + 1) gc_remembered[n] = 0;
+}
+
+
+/****************************************
+ * Where a surviving cell is going to   *
+ * end up after compaction; which is    *
+ * simply the number of cells which     *
+ * survived below it. Anything that is  *
+ * not going to move (NULL, FILE* and   *
+ * cells below gc_compact_from) is left *
+ * alone.                               *
+ ****************************************/
+struct cell* forward_cell(struct cell* c)
+{
+	if(c < gc_compact_from) return c;
+	if(c > top_allocated) return c;
+
+	unsigned n = (c - gc_compact_from) / CELL_SIZE;
+	unsigned b = n >> 3;
+	int below = gc_live_bits[b] & ((1 << (n & 7)) - 1);
+	return gc_compact_from + ((gc_live_before[b] + gc_bit_count[below]) * CELL_SIZE);
+}
+
+
+/****************************************
+ * The ROOTs need to be forwarded just  *
+ * like any cell. The special symbols   *
+ * (nil, cell_t, s_if...) are the very  *
+ * first cells allocated and they live  *
+ * forever, so they never move.         *
+ ****************************************/
+void forward_roots()
+{
+	g_env = forward_cell(g_env);
+	all_symbols = forward_cell(all_symbols);
+	R0 = forward_cell(R0);
+	R1 = forward_cell(R1);
+	R2 = forward_cell(R2);
+	R3 = forward_cell(R3);
+	R4 = forward_cell(R4);
+	__c_stdin = forward_cell(__c_stdin);
+	__c_stdout = forward_cell(__c_stdout);
+	__c_stderr = forward_cell(__c_stderr);
+	token_stack = forward_cell(token_stack);
+	g_symbols_env = forward_cell(g_symbols_env);
+	forward_symbol_table();
+
+	int i = 0;
+	while(i < stack_pointer)
+	{
+		g_stack[i] = forward_cell(g_stack[i]);
+		i = i + 1;
+	}
+
+	for(i = 0; i < (SMALL_INTS + SMALL_CHARS); i = i + 1)
+	{
+		gc_small_cells[i] = forward_cell(gc_small_cells[i]);
+	}
+}
+
+
+/****************************************
+ * The remembered old cells may point   *
+ * into the nursery too and thus need   *
+ * to be forwarded as well; unless they *
+ * are being compacted themselves.      *
+ ****************************************/
+void forward_remembered()
+{
+	if(NULL == gc_old_boundary) return;
+
+	unsigned bytes = (((gc_old_boundary - gc_block_start) / CELL_SIZE) >> 3) + 1;
+	unsigned n;
+	int bit;
+	struct cell* i;
+	for(n = 0; n < bytes; n = n + 1)
+	{
+		if(0 != gc_remembered[n])
+		{
+			for(bit = 0; bit < 8; bit = bit + 1)
+			{
+				i = gc_block_start + ((((n << 3) + bit)) * CELL_SIZE);
+				if((i < gc_compact_from) && (0 != (gc_remembered[n] & (1 << bit))))
+				{
+					if(car_is_cell(i->type)) i->car = forward_cell(i->car);
+					i->cdr = forward_cell(i->cdr);
+					if(env_is_cell(i->type)) i->env = forward_cell(i->env);
+				}
+			}
+		}
+	}
+}
+
+
+/****************************************
+ * Likewise for the cells on the        *
+ * changed cards of the immortal        *
+ * region, which never move themselves. *
+ ****************************************/
+void forward_cards()
+{
+	if(NULL == gc_immortal) return;
+
+	unsigned cells = ((gc_immortal - gc_block_start) / CELL_SIZE) + 1;
+	unsigned n;
+	struct cell* i;
+	for(n = 0; n < cells; n = n + 1)
+	{
+		if(gc_cards[n >> GC_CARD_SHIFT])
+		{
+			i = gc_block_start + (n * CELL_SIZE);
+			if(car_is_cell(i->type)) i->car = forward_cell(i->car);
+			i->cdr = forward_cell(i->cdr);
+			if(env_is_cell(i->type)) i->env = forward_cell(i->env);
+		}
+	}
+}
+
+
+/****************************************
+ * Sliding (Lisp2 style) compaction of  *
+ * every cell above FROM, which is      *
+ * linear in the number of cells:       *
+ * 1) Record which cells survived       *
+ * 2) Count the survivors below every   *
+ *    byte of the bitmap which gives us *
+ *    all the forwarding addresses      *
+ * 3) Update every pointer in the       *
+ *    survivors and the ROOTs           *
+ * 4) Slide the survivors down in order *
+ *                                      *
+ *     * CORRECTNESS IS ESSENTIAL *     *
+ *                                      *
+ * Only safe when no C code is holding  *
+ * on to cells, as those pointers are   *
+ * not going to be updated. Any cell    *
+ * below FROM that could point above it *
+ * has to be remembered or on a changed *
+ * card.                                *
+ ****************************************/
+void compact(struct cell* from)
+{
+	gc_compact_from = from;
+	free_cells = NULL;
+	sweep_cursor = from;
+
+	/* Nothing to compact */
+	if((NULL == top_allocated) || (top_allocated < from)) return;
+
+	unsigned cells = ((top_allocated - from) / CELL_SIZE) + 1;
+	unsigned bytes = (cells >> 3) + 1;
+	unsigned n;
+	struct cell* i;
+
+	/* Step one: Record the survivors */
+	for(n = 0; n < bytes; n = n + 1) gc_live_bits[n] = 0;
+	for(n = 0; n < cells; n = n + 1)
+	{
+		i = from + (n * CELL_SIZE);
+		if((FREE != i->type) && !cell_marked(i))
+		{
+			gc_live_bits[n >> 3] = gc_live_bits[n >> 3] | (1 << (n & 7));
+		}
+	}
+
+	/* Step two: Count the survivors below each byte */
+	unsigned count = 0;
+	for(n = 0; n < bytes; n = n + 1)
+	{
+		gc_live_before[n] = count;
+		count = count + gc_bit_count[gc_live_bits[n] & 0xFF];
+	}
+
+	/* Step three: Update all pointers to their new location */
+	for(n = 0; n < cells; n = n + 1)
+	{
+		if(0 != (gc_live_bits[n >> 3] & (1 << (n & 7))))
+		{
+			i = from + (n * CELL_SIZE);
+			if(car_is_cell(i->type)) i->car = forward_cell(i->car);
+			i->cdr = forward_cell(i->cdr);
+			if(env_is_cell(i->type)) i->env = forward_cell(i->env);
+		}
+	}
+	forward_roots();
+	forward_cards();
+	if(from != gc_block_start) forward_remembered();
+
+	/* Step four: Slide everything down, lowest first so nothing is overwritten */
+	struct cell* target = from;
+	for(n = 0; n < cells; n = n + 1)
+	{
+		if(0 != (gc_live_bits[n >> 3] & (1 << (n & 7))))
+		{
+			i = from + (n * CELL_SIZE);
+			if(i != target)
+			{
+				target->type = i->type;
+				target->car = i->car;
+				target->cdr = i->cdr;
+				target->env = i->env;
+				gc_cells_moved = gc_cells_moved + 1;
+			}
+			target = target + CELL_SIZE;
+		}
+	}
+
+	/* Everything above the survivors is now one free region */
+	if(gc_block_start == target) top_allocated = NULL;
+	else top_allocated = target - CELL_SIZE;
+	sweep_cursor = target;
+}
+
+
+/****************************************
+ * The fields of a STRING_HEADER are    *
+ * stored a byte at a time, lowest      *
+ * first; as there is no other way to   *
+ * put an int into a char* without a    *
+ * cast.                                *
+ ****************************************/
+unsigned get_string_field(char* s, int field)
+{
+	s = s + (field * 4);
+	return (s[0] & 0xFF) | ((s[1] & 0xFF) << 8) | ((s[2] & 0xFF) << 16) | ((s[3] & 0xFF) << 24);
+}
+
+void set_string_field(char* s, int field, unsigned value)
+{
+	s = s + (field * 4);
+	s[0] = value & 0xFF;
+	s[1] = (value >> 8) & 0xFF;
+	s[2] = (value >> 16) & 0xFF;
+	s[3] = (value >> 24) & 0xFF;
+}
+
+
+/****************************************
+ * A centralized method of allocating   *
+ * the bytes of strings, which returns  *
+ * SIZE zeroed bytes just like calloc.  *
+ *                                      *
+ * Cells must only ever point to the    *
+ * start of what is returned, never     *
+ * into the middle of it.               *
+ *                                      *
+ * If the string heap is full we can    *
+ * not compact it in the middle of an   *
+ * evaluation, so we fall back to       *
+ * calloc and get the next safe point   *
+ * to make room.                        *
+ ****************************************/
+char* pop_string(unsigned size)
+{
+	if((gc_string_used + STRING_HEADER + size) > gc_string_size)
+	{
+		gc_string_pressure = TRUE;
+		return calloc(size, sizeof(char));
+	}
+
+	char* h = gc_string_start + gc_string_used;
+	gc_string_used = gc_string_used + STRING_HEADER + size;
+	if((gc_string_used + (gc_string_used >> 2)) > gc_string_size) gc_string_pressure = TRUE;
+
+	set_string_field(h, 0, size);
+	set_string_field(h, 1, FALSE);
+	set_string_field(h, 2, 0);
+
+	char* r = h + STRING_HEADER;
+	unsigned i;
+	for(i = 0; i < size; i = i + 1) r[i] = 0;
+	return r;
+}
+
+
+/****************************************
+ * Does the cell point to a string in   *
+ * the string heap.                     *
+ ****************************************/
+int has_heap_string(struct cell* c)
+{
+	int t = c->type;
+	if((STRING != t) && (SYM != t) && (KEYWORD != t) && (RECORD_TYPE != t) && (FILE_PORT != t)) return FALSE;
+	if(c->string < gc_string_start) return FALSE;
+	if(c->string >= (gc_string_start + gc_string_used)) return FALSE;
+	return TRUE;
+}
+
+
+/****************************************
+ * Sliding compaction of the string     *
+ * heap, which has to be done right     *
+ * after the cells have been compacted  *
+ * as it relies upon every cell up to   *
+ * top_allocated being live:            *
+ * 1) Flag every string a cell points to*
+ * 2) Work out where each one goes      *
+ * 3) Update the cells                  *
+ * 4) Slide the strings down in order   *
+ * Should the live strings still fill   *
+ * more than half of the string heap we *
+ * move them into one twice the size.   *
+ ****************************************/
+void compact_strings()
+{
+	struct cell* i;
+	char* h;
+	unsigned p;
+	unsigned size;
+
+	/* Step one: Flag the live strings */
+	for(i = gc_block_start; i <= top_allocated; i = i + CELL_SIZE)
+	{
+		if(has_heap_string(i)) set_string_field(i->string - STRING_HEADER, 1, TRUE);
+	}
+
+	/* Step two: Work out where each of them goes */
+	unsigned live = 0;
+	for(p = 0; p < gc_string_used; p = p + STRING_HEADER + size)
+	{
+		h = gc_string_start + p;
+		size = get_string_field(h, 0);
+		if(get_string_field(h, 1))
+		{
+			set_string_field(h, 2, live);
+			live = live + STRING_HEADER + size;
+		}
+	}
+
+	char* target = gc_string_start;
+	unsigned target_size = gc_string_size;
+	while((live << 1) > target_size) target_size = target_size << 1;
+	if(target_size != gc_string_size)
+	{
+		if(3 <= mes_debug_level)
+		{
+			file_print("EXPANDING STRING HEAP: ", stderr);
+			file_print(numerate_number(target_size), stderr);
+			file_print(" bytes now available\n", stderr);
+		}
+		target = malloc(target_size);
+		require(NULL != target, "unable to grow the string heap\n");
+	}
+
+	/* Step three: Update the cells */
+	for(i = gc_block_start; i <= top_allocated; i = i + CELL_SIZE)
+	{
+		if(has_heap_string(i)) i->string = target + get_string_field(i->string - STRING_HEADER, 2) + STRING_HEADER;
+	}
+
+	/* Step four: Slide everything down, lowest first so nothing is overwritten */
+	char* to;
+	unsigned j;
+	for(p = 0; p < gc_string_used; p = p + STRING_HEADER + size)
+	{
+		h = gc_string_start + p;
+		size = get_string_field(h, 0);
+		if(get_string_field(h, 1))
+		{
+			set_string_field(h, 1, FALSE);
+			to = target + get_string_field(h, 2);
+			if(to != h)
+			{
+				for(j = 0; j < (STRING_HEADER + size); j = j + 1) to[j] = h[j];
+			}
+		}
+	}
+
+	if(target != gc_string_start)
+	{
+		free(gc_string_start);
+		gc_string_start = target;
+		gc_string_size = target_size;
+	}
+	gc_string_used = live;
+	gc_string_pressure = FALSE;
+}
+
+
+/****************************************
+ * How low left_to_take may get before  *
+ * we collect; fixed by MES_SAFETY      *
+ * unless we are adapting.              *
+ ****************************************/
+unsigned gc_safety()
+{
+	if(0 != GC_OVERHEAD) return gc_trigger;
+	return GC_SAFETY;
+}
+
+
+/****************************************
+ * When pop_cons runs dry, should we    *
+ * grow the pool before trying to       *
+ * collect. Without MES_GC_OVERHEAD we  *
+ * always do, otherwise only when the   *
+ * pool is still small or the last      *
+ * collection freed too little or took  *
+ * too long.                            *
+ ****************************************/
+int gc_prefer_growth()
+{
+	if(0 == GC_OVERHEAD) return TRUE;
+	if(arena >= max_arena) return FALSE;
+	if(arena < GC_SMALL_POOL) return TRUE;
+	if(gc_last_survival > 50) return TRUE;
+	if(gc_last_overhead > GC_OVERHEAD) return TRUE;
+	return FALSE;
+}
+
+
+/****************************************
+ * After every collection look at how   *
+ * much survived and how much of our    *
+ * time went into collecting since the  *
+ * last one. Too much time or little    *
+ * garbage means we should collect less *
+ * often, which may require growing the *
+ * pool; while cheap collections that   *
+ * free most cells can happen more      *
+ * often, keeping the pool small.       *
+ ****************************************/
+void gc_adapt(SCM pause)
+{
+	SCM mutator = gc_started - gc_last_end;
+	gc_last_end = gc_started + pause;
+
+	gc_last_survival = 100;
+	if(0 != gc_in_use) gc_last_survival = (live_cells * 100) / gc_in_use;
+	gc_last_overhead = 0;
+	if(0 != (mutator + pause)) gc_last_overhead = (pause * 100) / (mutator + pause);
+
+	if((gc_last_overhead > GC_OVERHEAD) || (gc_last_survival > 50))
+	{
+		gc_budget = gc_budget * 2;
+		while((gc_budget > left_to_take) && (arena < max_arena)) expand_pool();
+	}
+	else if((gc_last_overhead < (GC_OVERHEAD / 2)) && (gc_budget > GC_MIN_BUDGET))
+	{
+		gc_budget = gc_budget / 2;
+	}
+
+	gc_trigger = 0;
+	if(left_to_take > gc_budget) gc_trigger = left_to_take - gc_budget;
+}
+
+
+/****************************************
+ * Every collection starts with         *
+ * gc_begin and ends with gc_end, which *
+ * keep the running totals and write    *
+ * the MES_GC_TRACE line.               *
+ ****************************************/
+void gc_begin()
+{
+	gc_started = clock_microseconds();
+	gc_in_use = (arena + 1) - left_to_take;
+	gc_moved_before = gc_cells_moved;
+}
+
+void gc_end(char* kind)
+{
+	SCM pause = clock_microseconds() - gc_started;
+	unsigned reclaimed = 0;
+	if(gc_in_use > live_cells) reclaimed = gc_in_use - live_cells;
+
+	gc_collections = gc_collections + 1;
+	gc_pause_total = gc_pause_total + pause;
+	if(pause > gc_pause_max) gc_pause_max = pause;
+	gc_cells_marked = gc_cells_marked + live_cells;
+	gc_cells_reclaimed = gc_cells_reclaimed + reclaimed;
+	if(0 != GC_OVERHEAD) gc_adapt(pause);
+
+	if(GC_TRACE)
+	{
+		file_print("GC ", stderr);
+		file_print(numerate_number(gc_collections), stderr);
+		file_print(": ", stderr);
+		file_print(kind, stderr);
+		file_print(" pause=", stderr);
+		file_print(numerate_number(pause), stderr);
+		file_print("us live=", stderr);
+		file_print(numerate_number(live_cells), stderr);
+		file_print(" reclaimed=", stderr);
+		file_print(numerate_number(reclaimed), stderr);
+		file_print(" moved=", stderr);
+		file_print(numerate_number(gc_cells_moved - gc_moved_before), stderr);
+		file_print(" arena=", stderr);
+		file_print(numerate_number(arena), stderr);
+		file_print(" left=", stderr);
+		file_print(numerate_number(left_to_take), stderr);
+		if(0 != GC_OVERHEAD)
+		{
+			file_print(" survival=", stderr);
+			file_print(numerate_number(gc_last_survival), stderr);
+			file_print("% overhead=", stderr);
+			file_print(numerate_number(gc_last_overhead), stderr);
+			file_print("% budget=", stderr);
+			file_print(numerate_number(gc_budget), stderr);
+		}
+		file_print("\n", stderr);
+	}
+}
+
+
+/****************************************
+ * The heap verifier, used with         *
+ * MES_GC_STRESS. Every pointer in a    *
+ * live cell or ROOT has to land on a   *
+ * cell in [gc_block_start,             *
+ * top_allocated] that is not FREE and, *
+ * unless we just COMPACTED (which      *
+ * leaves the mark bits behind), that   *
+ * the mark phase found to be live.     *
+ * Anything else means a ROOT or write  *
+ * barrier was missed, so we stop right *
+ * there rather than corrupt the heap.  *
+ ****************************************/
+void verify_cell(struct cell* c, char* what, struct cell* from, int compacted)
+{
+	if(NULL == c) return;
+
+	int bad = FALSE;
+	if((c < gc_block_start) || (c > top_allocated)) bad = TRUE;
+	else if(FREE == c->type) bad = TRUE;
+	else if(!compacted && cell_marked(c)) bad = TRUE;
+	if(!bad) return;
+
+	file_print("HEAP VERIFY FAILED: ", stderr);
+	file_print(what, stderr);
+	if(NULL != from)
+	{
+		file_print(" of cell ", stderr);
+		file_print(numerate_number((from - gc_block_start) / CELL_SIZE), stderr);
+		file_print(" of type ", stderr);
+		file_print(numerate_number(from->type), stderr);
+	}
+	file_print(" points to ", stderr);
+	if((c < gc_block_start) || (c > top_allocated)) file_print("outside of the pool\n", stderr);
+	else if(FREE == c->type) file_print("a FREE cell\n", stderr);
+	else file_print("a cell that is not live\n", stderr);
+	exit(EXIT_FAILURE);
+}
+
+void verify_heap(int compacted)
+{
+	verify_cell(g_env, "g_env", NULL, compacted);
+	verify_cell(all_symbols, "all_symbols", NULL, compacted);
+	verify_cell(R0, "R0", NULL, compacted);
+	verify_cell(R1, "R1", NULL, compacted);
+	verify_cell(R2, "R2", NULL, compacted);
+	verify_cell(R3, "R3", NULL, compacted);
+	verify_cell(R4, "R4", NULL, compacted);
+	verify_cell(__c_stdin, "__c_stdin", NULL, compacted);
+	verify_cell(__c_stdout, "__c_stdout", NULL, compacted);
+	verify_cell(__c_stderr, "__c_stderr", NULL, compacted);
+	verify_cell(token_stack, "token_stack", NULL, compacted);
+	verify_cell(g_symbols_env, "g_symbols_env", NULL, compacted);
+
+	int n;
+	for(n = 0; n < stack_pointer; n = n + 1) verify_cell(g_stack[n], "g_stack", NULL, compacted);
+
+	if(NULL == top_allocated) return;
+	struct cell* i;
+	for(i = gc_block_start; i <= top_allocated; i = i + CELL_SIZE)
+	{
+		if((FREE != i->type) && (compacted || !cell_marked(i)))
+		{
+			if(car_is_cell(i->type)) verify_cell(i->car, "CAR", i, compacted);
+			verify_cell(i->cdr, "CDR", i, compacted);
+			if(env_is_cell(i->type)) verify_cell(i->env, "ENV", i, compacted);
+		}
+	}
+}
+
+
+/****************************************
+ * A minor collection, which only looks *
+ * at the nursery and promotes whatever *
+ * survives into the old generation.    *
+ ****************************************/
+void collect_nursery()
+{
+	gc_begin();
+	struct cell* from = gc_old_boundary + CELL_SIZE;
+	mark_live_cells(from);
+	unmark_remembered();
+	compact(from);
+	clear_remembered();
+
+	gc_old_boundary = top_allocated;
+	left_to_take = (arena + 1) - live_cells;
+	gc_end("minor");
+}
+
+
+/****************************************
+ * A major collection, which looks at   *
+ * every cell and every string. If we   *
+ * are generational everything that     *
+ * survives is old.                     *
+ ****************************************/
+void collect_everything()
+{
+	gc_begin();
+	struct cell* from = gc_mortal_start();
+	mark_live_cells(from);
+	if(0 != GC_STRESS) verify_heap(FALSE);
+	compact(from);
+	compact_strings();
+	if(0 != GC_STRESS) verify_heap(TRUE);
+	clear_remembered();
+
+	gc_old_boundary = NULL;
+	if(0 != GC_NURSERY) gc_old_boundary = top_allocated;
+	gc_old_after_major = live_cells;
+	left_to_take = (arena + 1) - live_cells;
+	gc_end("major");
+}
+
+
+/****************************************
+ * Collect everything and make whatever *
+ * survives immortal, which leaves no   *
+ * mortal cells for the cards to point  *
+ * to.                                  *
+ ****************************************/
+void seal_heap()
+{
+	collect_everything();
+	gc_seal_requested = FALSE;
+	if(NULL == top_allocated) return;
+
+	gc_immortal = top_allocated;
+	unsigned cards = (((gc_immortal - gc_block_start) / CELL_SIZE) >> GC_CARD_SHIFT) + 1;
+	unsigned n;
+	for(n = 0; n < cards; n = n + 1) gc_cards[n] = FALSE;
+}
+
+
+/****************************************
+ * Have the next safe point seal the    *
+ * heap; for after the boot file and    *
+ * core:seal-heap.                      *
+ ****************************************/
+void request_seal()
+{
+	gc_seal_requested = TRUE;
+}
+
+struct cell* builtin_seal_heap(struct cell* args)
+{
+	require(nil == args, "core:seal-heap does not take arguments\n");
+	request_seal();
+	return cell_unspecified;
+}
+
+
+/****************************************
+ * The function that orchestrates the   *
+ * whole of the mark and compact        *
+ * garbage collection in mes-m2.        *
+ *                                      *
+ * Only to be called from a safe point  *
+ * (between top level expressions in    *
+ * load_file) where all cells still in  *
+ * use can be found from the ROOTs.     *
+ *                                      *
+ * As compaction is linear in the size  *
+ * of what is collected, we simply do   *
+ * it every time. This keeps            *
+ * top_allocated as low as possible and *
+ * leaves a single free region above    *
+ * it, so there is nothing left for the *
+ * sweeper to do.                       *
+ ****************************************/
+void garbage_collect()
+{
+	if(gc_seal_requested)
+	{
+		seal_heap();
+		return;
+	}
+
+	/* Only collecting everything makes room in the string heap */
+	if(gc_string_pressure)
+	{
+		collect_everything();
+		return;
+	}
+
+	/* Most of the marking has already been done between allocations */
+	if(gc_marking)
+	{
+		finish_incremental();
+		return;
+	}
+
+	if(0 != GC_NURSERY)
+	{
+		/* Collect the nursery once it is full or we are running out */
+		unsigned young = 0;
+		if(NULL != top_allocated) young = (top_allocated - gc_block_start) / CELL_SIZE + 1;
+		unsigned old = 0;
+		if(NULL != gc_old_boundary) old = (gc_old_boundary - gc_block_start) / CELL_SIZE + 1;
+		young = young - old;
+		if((GC_NURSERY > young) && (gc_safety() < left_to_take)) return;
+
+		/* Only once the old generation has doubled do we need to look at it again */
+		if((NULL != gc_old_boundary) && (old < (2 * gc_old_after_major)))
+		{
+			collect_nursery();
+			if(gc_safety() < left_to_take) return;
+		}
+	}
+	/* Make garbage collection lazy. aka don't do it until we are full or exceed the safety margin */
+	else if(gc_safety() < left_to_take) return;
+
+	collect_everything();
+}
+
+
+/****************************************
+ * When pop_cons runs dry in the middle *
+ * of an evaluation we are not allowed  *
+ * to move anything, as the C code up   *
+ * the stack is still holding on to     *
+ * cells. So we only find the live      *
+ * cells and leave reclaiming the rest  *
+ * to the lazy sweeper.                 *
+ ****************************************/
+void collect_in_place()
+{
+	gc_begin();
+	mark_live_cells(gc_mortal_start());
+	if(0 != GC_STRESS) verify_heap(FALSE);
+
+	/****************************************
+	 * Step two: reclaim marked cells       *
+	 *                                      *
+	 * Which is done lazily by pop_cons, so *
+	 * all we have to do here is to forget  *
+	 * the old free list and send the       *
+	 * sweeper back to the bottom of the    *
+	 * pool. Cells which were still on the  *
+	 * free list are FREE and thus will be  *
+	 * picked up again.                     *
+	 *                                      *
+	 * As the sweeper will hand out cells   *
+	 * below gc_old_boundary, there can no  *
+	 * longer be an old generation.         *
+	 ****************************************/
+	free_cells = NULL;
+	sweep_cursor = gc_mortal_start();
+	clear_remembered();
+	gc_old_boundary = NULL;
+	left_to_take = (arena + 1) - live_cells;
+	gc_end("in-place");
+}
+
+
+/****************************************
+ * Only collect in place once we are    *
+ * running low, just like the safe      *
+ * points do.                           *
+ ****************************************/
+void garbage_collect_in_place()
+{
+	if(gc_safety() < left_to_take) return;
+	collect_in_place();
+}
+
+
+/****************************************
+ * Called by pop_cons for every cell it *
+ * hands out with MES_GC_STRESS set, to *
+ * collect in place on every            *
+ * GC_STRESS-th one no matter how many  *
+ * cells are left; once there are ROOTs *
+ * to collect from.                     *
+ ****************************************/
+void gc_stress()
+{
+	/* main is still busy making the ROOTs */
+	if(NULL == __c_stderr) return;
+
+	gc_stress_count = gc_stress_count + 1;
+	if(gc_stress_count < GC_STRESS) return;
+	gc_stress_count = 0;
+	collect_in_place();
+}
+
+
+/****************************************
+ * Incremental marking, used when       *
+ * MES_GC_STEP is set. Once half of the *
+ * pool is in use pop_cons starts a     *
+ * mark and from then on every call     *
+ * looks at MES_GC_STEP gray cells      *
+ * before handing out a cell. By the    *
+ * next safe point there is little left *
+ * to do but finish the mark, rather    *
+ * than having to do all of it at once. *
+ *                                      *
+ * Cells reachable from the ROOTs but   *
+ * not yet looked at are gray, those    *
+ * looked at are black and the rest are *
+ * white (MARKED). As the mutator keeps *
+ * running, cells handed out during the *
+ * mark are gray and gc_write_barrier   *
+ * makes changed black cells gray again *
+ * so nothing they now point to gets    *
+ * missed.                              *
+ ****************************************/
+void gray_cell(struct cell* c)
+{
+	if(NULL == c) return;
+	if(!cell_marked(c)) return;
+	unmark_cell(c);
+	live_cells = live_cells + 1;
+	push_mark_stack(c);
+}
+
+
+/****************************************
+ * A freshly allocated cell is white    *
+ * or worse, left over from before the  *
+ * mark started. Either way it is live  *
+ * and about to be filled in.           *
+ ****************************************/
+void allocate_gray(struct cell* c)
+{
+	unmark_cell(c);
+	live_cells = live_cells + 1;
+	push_mark_stack(c);
+}
+
+
+/****************************************
+ * The ROOTs change all of the time     *
+ * without a write barrier, so they are *
+ * made gray when the mark starts and   *
+ * again right before it finishes.      *
+ ****************************************/
+void gray_roots()
+{
+	gray_cell(g_env);
+	gray_cell(all_symbols);
+	gray_cell(R0);
+	gray_cell(R1);
+	gray_cell(R2);
+	gray_cell(R3);
+	gray_cell(R4);
+	gray_cell(__c_stdin);
+	gray_cell(__c_stdout);
+	gray_cell(__c_stderr);
+	gray_cell(token_stack);
+	gray_cell(g_symbols_env);
+	keep_small_cells();
+	keep_cards();
+
+	int i;
+	for(i = 0; i < stack_pointer; i = i + 1) gray_cell(g_stack[i]);
+}
+
+
+/****************************************
+ * Turn up to BUDGET gray cells black   *
+ * by making everything they point to   *
+ * gray.                                *
+ ****************************************/
+void mark_gray_cells(unsigned budget)
+{
+	struct cell* i;
+	while((0 < budget) && (0 < gc_mark_stack_pointer))
+	{
+		gc_mark_stack_pointer = gc_mark_stack_pointer - 1;
+		i = gc_mark_stack[gc_mark_stack_pointer];
+		if(car_is_cell(i->type)) gray_cell(i->car);
+		if(env_is_cell(i->type)) gray_cell(i->env);
+		gray_cell(i->cdr);
+		budget = budget - 1;
+	}
+}
+
+
+/****************************************
+ * Start an incremental mark by making  *
+ * every cell white and the ROOTs gray. *
+ * The sweeper may not be done with the *
+ * bits of the last mark yet, which is  *
+ * why it only takes FREE cells until   *
+ * this one is finished.                *
  ****************************************/
-struct cell* top_allocated;
+void start_incremental()
+{
+	live_cells = (gc_mortal_start() - gc_block_start) / CELL_SIZE;
+	mark_all_cells(gc_mortal_start());
+	gc_mark_stack_pointer = 0;
+	gc_marking = TRUE;
+	gray_roots();
+}
 
 
 /****************************************
- * If one wishes to allocate from the   *
- * bottom of memory to the top to make  *
- * compaction easier to reason about;   *
- * one needs to allocate memory from    *
- * low to high and a sorted free list   *
- * makes that task much faster.         *
+ * Gray the ROOTs one last time and     *
+ * mark whatever is still gray all at   *
+ * once, which only this final part     *
+ * counts as a pause. Then, just like   *
+ * garbage_collect_in_place, reclaiming *
+ * the white cells is left to the lazy  *
+ * sweeper.                             *
+ *                                      *
+ * As C code up the stack may be        *
+ * holding on to white cells this is    *
+ * only done at a safe point; should    *
+ * pop_cons run dry before then it      *
+ * falls back on growing the pool or    *
+ * garbage_collect_in_place, which      *
+ * abandons the mark.                   *
  ****************************************/
-struct cell* insert_ordered(struct cell* i, struct cell* list)
+void finish_incremental()
 {
-	/* Deal with rare end case */
-	if(NULL == list) return i;
+	gc_begin();
+	gray_roots();
+	while(0 < gc_mark_stack_pointer) mark_gray_cells(SWEEP_BLOCK);
+	gc_marking = FALSE;
+	if(0 != GC_STRESS) verify_heap(FALSE);
 
-	/* Most common case, insert at head of list */
-	if(i < list)
-	{
-		i->cdr = list;
-		return i;
-	}
+	free_cells = NULL;
+	sweep_cursor = gc_mortal_start();
+	clear_remembered();
+	gc_old_boundary = NULL;
+	left_to_take = (arena + 1) - live_cells;
 
-	/* Deal with worst case */
-	struct cell* head = list;
-	while(NULL != head)
+	/* Otherwise the next mark would start right away */
+	if(0 == GC_OVERHEAD)
 	{
-		/* If we went all the way to the end of the list */
-		if(NULL == head->cdr)
-		{
-			head->cdr = i;
-			break;
-		}
-		else if(i < head->cdr)
-		{
-			/* Inserting anywhere in between */
-			i->cdr = head->cdr;
-			head->cdr = i;
-			break;
-		}
-		head = head->cdr;
+		while((left_to_take <= ((arena + 1) >> 1)) && (arena < max_arena)) expand_pool();
 	}
-	return list;
+	gc_end("incremental");
 }
 
 
 /****************************************
- * A centralized method of allocating   *
- * the free cells to calling functions  *
- *                                      *
- * An ideal place to catch memory       *
- * exhustion errors and engage in       *
- * active garbage collection.           *
- *                                      *
- * The returned cell should have ALL    *
- * fields equal to NULL.                *
+ * Called by pop_cons for every cell it *
+ * hands out, to either start a mark or *
+ * do the next MES_GC_STEP of it.       *
+ * Running out of gray cells does not   *
+ * make us done, as the mutator can     *
+ * always make more.                    *
  ****************************************/
-struct cell* pop_cons()
+void gc_mark_step()
 {
-	if(NULL == free_cells)
+	if(!gc_marking)
 	{
-		/* We have to get free cells if possible */
-		expand_pool();
-		garbage_collect();
-		require(NULL != free_cells, "OOOPS we ran out of cells\n");
+		if(left_to_take > ((arena + 1) >> 1)) return;
+		start_incremental();
+		return;
 	}
-	struct cell* i;
-	i = free_cells;
-	free_cells = i->cdr;
-	i->cdr = NULL;
-	left_to_take = left_to_take - 1;
 
-	/* See if we need to move up */
-	if(i > top_allocated) top_allocated = i;
-
-	return i;
+	mark_gray_cells(GC_STEP);
 }
 
 
 /****************************************
- * A centralized method of freeing      *
- * cells to calling functions.          *
+ * Make sure the first CELLS cells of   *
+ * the pool are usable memory, a        *
+ * COMMIT_CHUNK at a time.              *
  ****************************************/
-void free_cons(struct cell* i)
+void commit_cells(unsigned cells)
 {
-	i->type = FREE;
-	i->car = NULL;
-	i->cdr = NULL;
-	i->env = NULL;
-	free_cells = insert_ordered(i, free_cells);
-	left_to_take = left_to_take + 1;
+	size_t needed = cells * sizeof(struct cell);
+	if(needed <= gc_committed) return;
+
+	needed = ((needed + COMMIT_CHUNK - 1) / COMMIT_CHUNK) * COMMIT_CHUNK;
+	if(needed > gc_reserved) needed = gc_reserved;
+	require(commit_memory(gc_block_start, gc_committed, needed - gc_committed), "unable to commit memory for the pool\n");
+	gc_committed = needed;
 }
 
 
 /****************************************
- * The Sweep part of the Mark and sweep *
- * garbage collection.                  *
- *                                      *
- *  *One of few performance critical*   *
- *                                      *
- * By sweeping from high to low memory  *
- * addresses we reduce the number of    *
- * recursions needed by insert_ordered  *
- * on average as high blocks should be  *
- * freed more frequently than low       *
- * blocks.                              *
+ * Increase the size of the pool by     *
+ * doubling until max pool size is      *
+ * reached                              *
  ****************************************/
-void reclaim_marked()
+void expand_pool()
 {
-	struct cell* i;
-	for(i= top_allocated; i >= gc_block_start ; i = i - CELL_SIZE)
+	if(3 <= mes_debug_level)
+	{
+		file_print("EXPANDING POOL: ", stderr);
+		file_print(numerate_number(arena), stderr);
+		file_print(" cells now available\n", stderr);
+	}
+
+	if(arena < max_arena)
 	{
-		if(i->type & MARKED) free_cons(i);
+		/* The new cells are above top_allocated, so the sweeper will just find them */
+		unsigned old = arena;
+		arena = arena * 2;
+		if(arena > max_arena) arena = max_arena;
+		commit_cells(arena + 1);
+		left_to_take = left_to_take + (arena - old);
+		gc_expansions = gc_expansions + 1;
 	}
 }
 
 
 /****************************************
- * Compaction require relocation of     *
- * cells and the correction of all      *
- * references to those cells.           *
- *                                      *
- *     * CORRECTNESS IS ESSENTIAL *     *
- *  *CRITICAL TO COMPACTION PERFORMACE* *
+ * We need to create our pool of cells  *
+ * to work with in the first place      *
  *                                      *
- * TODO: ensure correctness before      *
- * enabling function.                   *
+ * Now that we have a block of memory   *
+ * (in a possibly unknown state) we     *
+ * don't need to touch it at all, as    *
+ * nothing above top_allocated is ever  *
+ * looked at by anything other than the *
+ * sweeper; which treats it as free.    *
  ****************************************/
-void relocate_cell(struct cell* current, struct cell* target)
+void garbage_init()
 {
-	struct cell* i;
-	for(i = gc_block_start; i <= top_allocated; i = i + CELL_SIZE)
+	/* Reserve our entire pool in one action but only use what we need */
+	gc_reserved = (((max_arena + 1) * sizeof(struct cell) + COMMIT_CHUNK - 1) / COMMIT_CHUNK) * COMMIT_CHUNK;
+	gc_block_start = reserve_memory(gc_reserved);
+	require(NULL != gc_block_start, "unable to reserve memory for the pool\n");
+	gc_committed = 0;
+	commit_cells(arena + 1);
+
+	/* Nothing has happened yet */
+	gc_collections = 0;
+	gc_pause_total = 0;
+	gc_pause_max = 0;
+	gc_cells_marked = 0;
+	gc_cells_reclaimed = 0;
+	gc_cells_moved = 0;
+	gc_cells_allocated = 0;
+	g_applications = 0;
+	gc_expansions = 0;
+	gc_top_high = 0;
+
+	/* Until we know better let a whole arena be allocated between collections */
+	gc_budget = arena;
+	if(gc_budget < GC_MIN_BUDGET) gc_budget = GC_MIN_BUDGET;
+	gc_trigger = 0;
+	gc_last_survival = 0;
+	gc_last_overhead = 0;
+	gc_last_end = clock_microseconds();
+	left_to_take = arena + 1;
+	live_cells = 0;
+
+	/* The side tables compaction needs */
+	gc_live_bits = malloc((max_arena >> 3) + 2);
+	gc_live_before = malloc(((max_arena >> 3) + 2) * sizeof(int));
+	gc_bit_count = calloc(256, sizeof(char));
+	int n;
+	int b;
+	for(n = 0; n < 256; n = n + 1)
 	{
-		/* Deal with TYPE that set CAR to be other cells */
-		if((i->type == CONS) || (i->type == RECORD) || (i->type == LAMBDA) || (i->type == MACRO))
+		for(b = n; 0 != b; b = b >> 1)
 		{
-			/* If the cell's CAR is set to point to current, change it to target */
-			if(current == i->car) i->car = target;
+			gc_bit_count[n] = gc_bit_count[n] + (b & 1);
 		}
+	}
 
-		/* Deal with the TYPES that set ENV to be other cells */
-		if((i->type == LAMBDA) || (i->type == MACRO))
-		{
-			/* If the cell's ENV is set to point to current, change it to target */
-			if(current == i->env) i->env = target;
-		}
+	/* Every cell could end up old and remembered */
+	gc_remembered = calloc((max_arena >> 3) + 2, sizeof(char));
+	gc_old_boundary = NULL;
+	gc_old_after_major = 0;
 
-		/* Deal with the CDR case */
-		if(current == i->cdr) i->cdr = target;
-	}
-}
+	/* The first safe point seals what init_sl3 is about to make */
+	gc_cards = calloc((max_arena >> GC_CARD_SHIFT) + 2, sizeof(char));
+	gc_immortal = NULL;
+	gc_seal_requested = TRUE;
+	gc_stress_count = 0;
 
+	/* Only the live cells get their bit set */
+	if(GC_MARK_BITMAP) gc_mark_bits = calloc((max_arena >> 3) + 2, sizeof(char));
 
-/****************************************
- * The core of compaction, finding      *
- * cells that in a higher address than  *
- * available free cells, then having    *
- * those relocated.                     *
- ****************************************/
-void compact()
-{
-	struct cell* temp;
+	/* The string heap grows when compacted */
+	gc_string_start = malloc(STRING_HEAP_SIZE);
+	gc_string_size = STRING_HEAP_SIZE;
+	gc_string_used = 0;
+	gc_string_pressure = FALSE;
+
+	/* The mark stack grows as needed */
+	gc_mark_stack = calloc(MARK_STACK_SIZE, sizeof(struct cell*));
+	gc_mark_stack_size = MARK_STACK_SIZE;
+	gc_mark_stack_pointer = 0;
+	gc_mark_stack_high = 0;
+
+	/* Without the side bitmap marking changes the TYPE the mutator looks at */
+	gc_marking = FALSE;
+	if(!GC_MARK_BITMAP) GC_STEP = 0;
+
+	/* Nor can the parallel marker set bits in it; it only ever gets the ROOTs */
+	if(!GC_MARK_BITMAP) GC_THREADS = 0;
+	if(1 < GC_THREADS) gc_roots = calloc(MAX_STACK + 12, sizeof(struct cell*));
+
+	/* We start at the bottom of the pool for garbage collection */
+	free_cells = NULL;
+	sweep_cursor = gc_block_start;
+	top_allocated = NULL;
 
-	/* Do the actual compaction */
-	for(; gc_block_start >= top_allocated; top_allocated = top_allocated - CELL_SIZE)
+	/* Which is where the shared INTs and CHARs go, ahead of everything else */
+	while(arena < (SMALL_INTS + SMALL_CHARS)) expand_pool();
+	gc_small_cells = calloc(SMALL_INTS + SMALL_CHARS, sizeof(struct cell*));
+	struct cell* c;
+	for(n = 0; n < (SMALL_INTS + SMALL_CHARS); n = n + 1)
 	{
-		if(top_allocated < free_cells)
+		c = gc_block_start + (n * CELL_SIZE);
+		c->car = NULL;
+		c->cdr = NULL;
+		c->env = NULL;
+		if(n < SMALL_INTS)
 		{
-			/* When we reached the end of compaction possible */
-			break;
+			c->type = INT;
+			c->value = n - SMALL_INT_BIAS;
 		}
-
-		if(FREE != top_allocated->type)
+		else
 		{
-			/****************************************
-			 * Might cause garbage collection       *
-			 * inside of garbage collection but     *
-			 * only we run out of cells between the *
-			 * reclaiming of free cells and the     *
-			 * compaction of utilized cells.        *
-			 *                                      *
-			 * Which will result in alot of         *
-			 * duplicate work and worse performance *
-			 * but should not result in exhustion   *
-			 * nor crashes.                         *
-			 ****************************************/
-			temp = pop_cons();
-			temp->type = top_allocated->type;
-			temp->car = top_allocated->car;
-			temp->cdr = top_allocated->cdr;
-			temp->env = top_allocated->env;
-			relocate_cell(top_allocated, temp);
-
-			/* Garbage collect cell */
-			free_cons(top_allocated);
+			c->type = CHAR;
+			c->value = n - SMALL_INTS;
 		}
+		gc_small_cells[n] = c;
 	}
+	top_allocated = c;
+	sweep_cursor = c + CELL_SIZE;
+	left_to_take = left_to_take - (SMALL_INTS + SMALL_CHARS);
+	gc_top_high = SMALL_INTS + SMALL_CHARS;
 }
 
 
 /****************************************
- * The first half of the mark phase of  *
- * mark and sweep.                      *
- *                                      *
- *  *One of few performance critical*   *
- *                                      *
- * The bottom 2 bits of the TYPE are    *
- * reserved with the bottom bit         *
- * explicitly for MARKED. This is to    *
- * prevent changing of types when       *
- * marking cells. This is done from low *
- * to high to allow optimaizations like *
- * only having to mark cells that are   *
- * not already free.                    *
- * You don't want to mark FREE cells so *
- * That if you wish to later remove the *
- * counting of free cells at the end    *
- * you can do so without the fear of    *
- * double counting.                     *
+ * An alist of the running totals of    *
+ * the garbage collector, so that       *
+ * MES_ARENA and friends can be tuned   *
+ * against real numbers.                *
  ****************************************/
-void mark_all_cells()
+struct cell* gc_stat(char* name, SCM value, struct cell* tail)
 {
-	struct cell* i;
-	for(i = gc_block_start; i <= top_allocated; i = i + CELL_SIZE)
-	{
-		/* if not in the free list */
-		if(i->type != FREE)
-		{
-			/* Mark it */
-			i->type = i->type | MARKED;
-		}
-	}
+	/* Keep what we have so far safe while we allocate */
+	push_cell(tail);
+	struct cell* sym = intern(name);
+	struct cell* r = make_cons(make_cons(sym, make_int(value)), tail);
+	pop_cell();
+	return r;
+}
+
+struct cell* builtin_gc_stats(struct cell* args)
+{
+	require(nil == args, "core:gc-stats does not take arguments\n");
+	struct cell* r = nil;
+	unsigned immortal = 0;
+	if(NULL != gc_immortal) immortal = ((gc_immortal - gc_block_start) / CELL_SIZE) + 1;
+	r = gc_stat("immortal-cells", immortal, r);
+	r = gc_stat("top-high-water", gc_top_high, r);
+	r = gc_stat("expansions", gc_expansions, r);
+	r = gc_stat("applications", g_applications, r);
+	r = gc_stat("cells-allocated", gc_cells_allocated, r);
+	r = gc_stat("cells-moved", gc_cells_moved, r);
+	r = gc_stat("cells-reclaimed", gc_cells_reclaimed, r);
+	r = gc_stat("cells-marked", gc_cells_marked, r);
+	r = gc_stat("max-pause-us", gc_pause_max, r);
+	r = gc_stat("total-pause-us", gc_pause_total, r);
+	r = gc_stat("collections", gc_collections, r);
+	return r;
 }
 
 
 /****************************************
- * The second half of the mark phase of *
- * mark and sweep.                      *
- *                                      *
- *  *One of few performance critical*   *
- *     * CORRECTNESS IS ESSENTIAL *     *
- *                                      *
- * Essentially we need to UNMARK all    *
- * cells which we do not want garbage   *
- * collected.                           *
- *                                      *
- * This function needs to be called on  *
- * ALL ROOTs if any are missed we are   *
- * going to lose data and suffer from   *
- * CORRUPTION which will crash your     *
- * program in hard to debug ways.       *
+ * The census counts cells by TYPE in   *
+ * these slots.                         *
  ****************************************/
-void unmark_cells(struct cell* i)
+int census_slot(int type)
 {
-	/* Iteratively walk through cdrs because that path is the most numerous */
-	for(; NULL != i; i = i->cdr)
-	{
-		require(NULL != i, "unmark_cells impossible cell\n");
-		/* If we hit an unmarked cell it means we already did that tree so STOP */
-		if(0 == (i->type & MARKED)) return;
-		i->type = i->type & ~MARKED;
+	if(CONS == type) return 0;
+	if(STRING == type) return 1;
+	if(SYM == type) return 2;
+	if(INT == type) return 3;
+	if(CHAR == type) return 4;
+	if(LAMBDA == type) return 5;
+	if(MACRO == type) return 6;
+	if(PRIMOP == type) return 7;
+	if(VECTOR == type) return 8;
+	if(RECORD == type) return 9;
+	if(RECORD_TYPE == type) return 10;
+	if(KEYWORD == type) return 11;
+	if(FILE_PORT == type) return 12;
+	if(EOF_object == type) return 13;
+	return 14;
+}
 
-		/* Deal with TYPE that set CAR to be other cells */
-		if((i->type == CONS) || (i->type == RECORD) || (i->type == LAMBDA) || (i->type == MACRO))
-		{
-			require(NULL != i->car, "unmark_cells impossible car\n");
-			unmark_cells(i->car);
-		}
+char* census_name(int slot)
+{
+	if(0 == slot) return "cons";
+	if(1 == slot) return "string";
+	if(2 == slot) return "symbol";
+	if(3 == slot) return "int";
+	if(4 == slot) return "char";
+	if(5 == slot) return "lambda";
+	if(6 == slot) return "macro";
+	if(7 == slot) return "primop";
+	if(8 == slot) return "vector";
+	if(9 == slot) return "record";
+	if(10 == slot) return "record-type";
+	if(11 == slot) return "keyword";
+	if(12 == slot) return "port";
+	if(13 == slot) return "eof";
+	return "other";
+}
+
+
+/****************************************
+ * Count every cell reachable from C    *
+ * that has not been seen yet, walking  *
+ * them the same way unmark_cells does  *
+ * but with census_seen instead of the  *
+ * mark bits; so a census can be taken  *
+ * at any time, even in the middle of   *
+ * an incremental mark whose gray cells *
+ * stay below ours on the mark stack.   *
+ ****************************************/
+unsigned census_cells(struct cell* c)
+{
+	if(NULL == c) return 0;
+	unsigned found = 0;
+	unsigned base = gc_mark_stack_pointer;
+	unsigned n;
+	struct cell* i;
+	push_mark_stack(c);
 
-		/* Deal with the TYPES that set ENV to be other cells */
-		if((i->type == LAMBDA) || (i->type == MACRO))
+	while(base < gc_mark_stack_pointer)
+	{
+		gc_mark_stack_pointer = gc_mark_stack_pointer - 1;
+		i = gc_mark_stack[gc_mark_stack_pointer];
+		for(; NULL != i; i = i->cdr)
 		{
-			require((NULL != i->env), "unmark_cells impossible env\n");
-			unmark_cells(i->env);
+			n = (i - gc_block_start) / CELL_SIZE;
+			if(0 != (census_seen[n >> 3] & (1 << (n & 7)))) break;
+			census_seen[n >> 3] = census_seen[n >> 3] | (1 << (n & 7));
+			found = found + 1;
+			census_counts[census_slot(i->type)] = census_counts[census_slot(i->type)] + 1;
+
+			if(car_is_cell(i->type) && (NULL != i->car)) push_mark_stack(i->car);
+			if(env_is_cell(i->type) && (NULL != i->env)) push_mark_stack(i->env);
 		}
 	}
+	return found;
 }
 
 
 /****************************************
- * Nearly all of the essential roots    *
- * are created during evaluation and    *
- * need to be protected from garbage    *
- * collection until the evaluation      *
- * completes. Thus they are pushed unto *
- * the stack and will be unmarked as    *
- * efficiently as possible              *
- *                                      *
- *     * CORRECTNESS IS ESSENTIAL *     *
- * never push non-cells onto the stack  *
- *                                      *
- * NULL vales are fine but promptly     *
- * ignored by unmark_cells.             *
- * The stack pointer always points to   *
- * the first free cell on the stack.    *
+ * Count what is first found from the   *
+ * ROOT called NAME (INDEX being the    *
+ * g_stack slot or -1) and keep it in   *
+ * census_top_* if it is among the ones *
+ * keeping the most cells alive.        *
  ****************************************/
-void unmark_stack()
+void census_root(char* name, int index, struct cell* root)
 {
-	unsigned i = 0;
-	struct cell* s;
-	while(i < stack_pointer)
+	unsigned found = census_cells(root);
+	if(0 == found) return;
+
+	int i = CENSUS_TOP - 1;
+	if(found <= census_top_cells[i]) return;
+	while((0 < i) && (found > census_top_cells[i - 1]))
 	{
-		s = g_stack[i];
-		unmark_cells(s);
-		i = i + 1;
+		census_top_cells[i] = census_top_cells[i - 1];
+		census_top_name[i] = census_top_name[i - 1];
+		census_top_index[i] = census_top_index[i - 1];
+		i = i - 1;
 	}
+	census_top_cells[i] = found;
+	census_top_name[i] = name;
+	census_top_index[i] = index;
 }
 
 
 /****************************************
- * The function that orchestrates the   *
- * whole of the mark and sweep garbage  *
- * collection in mes-m2.                *
- *                                      *
- *     * CORRECTNESS IS ESSENTIAL *     *
- *                                      *
- * If any ROOTs are missed here the     *
- * damage will not be fixable.          *
- * This is also the point where         *
- * compaction is enabled/disabled       *
+ * Take a census of every live cell.    *
+ * The symbols go first so they are not *
+ * blamed on whatever binding happens   *
+ * to use them first, then every        *
+ * binding in g_env on its own, then    *
+ * the rest of the ROOTs.               *
  ****************************************/
-void garbage_collect()
+void census()
 {
-	/* Make garbage collection lazy. aka don't do it until we are full or exceed the safety margin */
-	if(GC_SAFETY < left_to_take) return;
-
-	/* Step zero: mark all cells */
-	mark_all_cells();
-
-	/* Step one: unmark cells we want to keep */
-	unmark_cells(g_env);
-	unmark_cells(all_symbols);
-	unmark_cells(R0);
-	unmark_cells(R1);
-	unmark_cells(R2);
-	unmark_cells(R3);
-	unmark_cells(R4);
-	__c_stdin->type = __c_stdin->type & ~MARKED;
-	__c_stdout->type = __c_stdout->type & ~MARKED;
-	__c_stderr->type = __c_stderr->type & ~MARKED;
-	unmark_stack();
+	census_seen = calloc((arena >> 3) + 2, sizeof(char));
+	census_counts = calloc(15, sizeof(unsigned));
+	census_top_cells = calloc(CENSUS_TOP, sizeof(unsigned));
+	census_top_name = calloc(CENSUS_TOP, sizeof(char*));
+	census_top_index = calloc(CENSUS_TOP, sizeof(int));
+	require(NULL != census_top_index, "unable to allocate the heap census\n");
 
-	/* Step two: reclaim marked cells */
-	reclaim_marked();
+	census_root("all_symbols", -1, all_symbols);
 
-	/****************************************
-	 * Optional step three: compact cells   *
-	 *                                      *
-	 * This is expensive so we only want to *
-	 * do it if we are seriously fragmented *
-	 * such as when top_allocated is more   *
-	 * than 2 times as high as it should be *
-	 * or when it finally hits the top of   *
-	 * the pool                             *
-	 *                                      *
-	 * Numbers higher than 2 don't produce  *
-	 * meaningful improvements in the       *
-	 * tested workloads                     *
-	 * 1 => 20.8s, 2 => 15.3s... 8 => 15.2s *
-	 * But never garbage collecting has a   *
-	 * performance of 16.3s, so a 7% boost  *
-	 * Feel free to strip out if not needed *
-	 * as it only is helpful in worst case  *
-	 * garbage collection patterns where    *
-	 * there is a cell allocated at the top *
-	 * of the pool (or near it) and thus    *
-	 * cycles are wasted marking all the    *
-	 * way up there. Thus really helpful    *
-	 * when the number of cells grows big   *
-	 ****************************************/
-	if(((arena - left_to_take) * 2) < ((top_allocated - gc_block_start) / CELL_SIZE))
-	{
-		compact();
-	}
-	else if(top_allocated == (gc_block_start + (CELL_SIZE * arena)))
+	struct cell* i;
+	unsigned n;
+	for(i = g_env; (NULL != i) && (nil != i); i = i->cdr)
 	{
-		compact();
+		/* Just the spine itself, the bindings are counted one by one */
+		n = (i - gc_block_start) / CELL_SIZE;
+		if(0 != (census_seen[n >> 3] & (1 << (n & 7)))) break;
+		census_seen[n >> 3] = census_seen[n >> 3] | (1 << (n & 7));
+		census_counts[census_slot(i->type)] = census_counts[census_slot(i->type)] + 1;
+
+		if((CONS == i->car->type) && (SYM == i->car->car->type)) census_root(i->car->car->string, -1, i->car);
+		else census_root("g_env", -1, i->car);
 	}
+
+	census_root("R0", -1, R0);
+	census_root("R1", -1, R1);
+	census_root("R2", -1, R2);
+	census_root("R3", -1, R3);
+	census_root("R4", -1, R4);
+	census_root("current-input-port", -1, __c_stdin);
+	census_root("current-output-port", -1, __c_stdout);
+	census_root("current-error-port", -1, __c_stderr);
+	census_root("token_stack", -1, token_stack);
+	census_root("g_symbols_env", -1, g_symbols_env);
+
+	int s;
+	for(s = 0; s < stack_pointer; s = s + 1) census_root("stack slot", s, g_stack[s]);
+}
+
+void census_done()
+{
+	free(census_seen);
+	free(census_counts);
+	free(census_top_cells);
+	free(census_top_name);
+	free(census_top_index);
 }
 
 
 /****************************************
- * Increase the size of the pool by     *
- * doubling until max pool size is      *
- * reached                              *
+ * What is filling up the heap, for     *
+ * when MES_HEAP_DUMP is set and we are *
+ * about to run out of cells.           *
  ****************************************/
-void expand_pool()
+void heap_dump()
 {
-	if(3 <= mes_debug_level)
+	census();
+	file_print("HEAP DUMP: live cells by type\n", stderr);
+	int i;
+	for(i = 0; i < 15; i = i + 1)
 	{
-		file_print("EXPANDING POOL: ", stderr);
-		file_print(numerate_number(arena), stderr);
-		file_print(" cells now available\n", stderr);
+		if(0 != census_counts[i])
+		{
+			file_print("  ", stderr);
+			file_print(census_name(i), stderr);
+			file_print(": ", stderr);
+			file_print(numerate_number(census_counts[i]), stderr);
+			file_print("\n", stderr);
+		}
 	}
 
-	if(arena < max_arena)
+	file_print("HEAP DUMP: roots keeping the most cells alive\n", stderr);
+	for(i = 0; i < CENSUS_TOP; i = i + 1)
 	{
-		arena = arena * 2;
-		if(arena > max_arena) arena = max_arena;
-		struct cell* i = gc_block_start + (arena * CELL_SIZE);
-
-		for(; i > top_allocated ; i = i - CELL_SIZE)
+		if(0 != census_top_cells[i])
 		{
-			free_cons(i);
+			file_print("  ", stderr);
+			file_print(census_top_name[i], stderr);
+			if(0 <= census_top_index[i])
+			{
+				file_print(" ", stderr);
+				file_print(numerate_number(census_top_index[i]), stderr);
+			}
+			file_print(": ", stderr);
+			file_print(numerate_number(census_top_cells[i]), stderr);
+			file_print(" cells\n", stderr);
 		}
 	}
+	census_done();
 }
 
 
 /****************************************
- * We need to create our pool of cells  *
- * to work with in the first place      *
- *                                      *
- * Now that we have a block of memory   *
- * (in a possibly unknown state) we     *
- * need to make it ready for general    *
- * use. We go from high to low to       *
- * reduce the number of cycles needed   *
- * to make our free list sorted from    *
- * low to high. (major part init speed) *
+ * An alist of how many live cells      *
+ * there are of each TYPE.              *
  ****************************************/
-void garbage_init()
+struct cell* builtin_heap_histogram(struct cell* args)
 {
-	/* Create our entire pool in one action */
-	gc_block_start = malloc((max_arena + 1) * sizeof(struct cell));
-	left_to_take = 0;
+	require(nil == args, "core:heap-histogram does not take arguments\n");
+	census();
 
-	/* We need to free everything before we can use it */
-	top_allocated = gc_block_start + (arena * CELL_SIZE);
-	free_cells = NULL;
-	struct cell* i;
-	for(i = top_allocated; i >= gc_block_start ; i = i - CELL_SIZE)
+	/* Copy the counts out before we allocate */
+	unsigned* counts = census_counts;
+	census_counts = NULL;
+	census_done();
+
+	struct cell* r = nil;
+	int i;
+	for(i = 14; 0 <= i; i = i - 1)
 	{
-		free_cons(i);
+		if(0 != counts[i]) r = gc_stat(census_name(i), counts[i], r);
 	}
-
-	/* We start at the bottom of the pool for garbage collection */
-	top_allocated = NULL;
+	free(counts);
+	return r;
 }
 
 
@@ -511,6 +2523,9 @@ void garbage_init()
  ****************************************/
 struct cell* make_int(int a)
 {
+	int n = a + SMALL_INT_BIAS;
+	if((0 <= n) && (n < SMALL_INTS)) return gc_small_cells[n];
+
 	struct cell* c = pop_cons();
 	c->type = INT;
 	c->value = a;
@@ -543,6 +2558,8 @@ struct cell* make_file(FILE* a, char* name)
  ****************************************/
 struct cell* make_char(int a)
 {
+	if((0 <= a) && (a < SMALL_CHARS)) return gc_small_cells[SMALL_INTS + a];
+
 	struct cell* c = pop_cons();
 	c->type = CHAR;
 	c->value = a;
@@ -572,6 +2589,10 @@ struct cell* make_string(char* a, int length)
  *    -----------------------------     *
  *   | SYM | POINTER | NULL | NULL |    *
  *    -----------------------------     *
+ * Once interned LENGTH holds its index *
+ * in the symbol table plus one, and    *
+ * the special forms have the INT of    *
+ * their syntax id in CDR.              *
  ****************************************/
 struct cell* make_sym(char* name)
 {
@@ -606,7 +2627,7 @@ struct cell* make_keyword(char* name)
  ****************************************/
 struct cell* make_cons(struct cell* a, struct cell* b)
 {
-	struct cell* c = pop_cons();
+	struct cell* c = pop_cons_holding(a, b, NULL);
 	c->type = CONS;
 	c->car = a;
 	c->cdr = b;
@@ -626,7 +2647,7 @@ struct cell* make_cons(struct cell* a, struct cell* b)
  ********************************************/
 struct cell* make_proc(struct cell* a, struct cell* b, struct cell* env)
 {
-	struct cell* c = pop_cons();
+	struct cell* c = pop_cons_holding(a, b, env);
 	c->type = LAMBDA;
 	c->car = a;
 	c->cdr = b;
@@ -647,7 +2668,7 @@ struct cell* make_proc(struct cell* a, struct cell* b, struct cell* env)
  ********************************************/
  struct cell* make_macro(struct cell* a, struct cell* b, struct cell* env)
 {
-	struct cell* c = pop_cons();
+	struct cell* c = pop_cons_holding(a, b, env);
 	c->type = MACRO;
 	c->car = a;
 	c->cdr = b;
@@ -670,6 +2691,30 @@ struct cell* make_prim(FUNCTION* fun)
 	return c;
 }
 
+/****************************************
+ * A PRIMOP may also declare an ARITY   *
+ * (CDR) and a FIXED entry point taking *
+ * that many arguments directly, which  *
+ * eval calls without consing a list.   *
+ * FUNCTION is left NULL when the FIXED *
+ * entry is the only one it has.        *
+ *  --------------------------------    *
+ * | PRIMOP | POINTER | INT | FIXED |   *
+ *  --------------------------------    *
+ ****************************************/
+struct cell* make_fixed_prim(FUNCTION* fun, FUNCTION* fixed, int arity)
+{
+	require(0 < arity, "mes_cell.c: fixed primitives take 1 to 3 arguments\n");
+	require(3 >= arity, "mes_cell.c: fixed primitives take 1 to 3 arguments\n");
+	struct cell* n = make_int(arity);
+	struct cell* c = pop_cons_holding(n, NULL, NULL);
+	c->type = PRIMOP;
+	c->function = fun;
+	c->cdr = n;
+	c->fixed = fixed;
+	return c;
+}
+
 /****************************************
  * Internally VECTOR is just a pointer  *
  * to a CONS list (CDR), its length     *
@@ -683,10 +2728,12 @@ struct cell* make_prim(FUNCTION* fun)
  ****************************************/
  struct cell* make_vector(int count, struct cell* init)
 {
-	/* Create Vector */
+	/* Create Vector, which has to be kept safe while we allocate its cons list */
+	push_cell(init);
 	struct cell* r = pop_cons();
 	r->type = VECTOR;
 	r->value = count;
+	push_cell(r);
 
 	/* Create cons list inside of vector */
 	struct cell* c;
@@ -700,6 +2747,8 @@ struct cell* make_prim(FUNCTION* fun)
 		c->cdr = i;
 		c = i;
 	}
+	pop_cell();
+	pop_cell();
 	return r;
 }
 
@@ -715,7 +2764,7 @@ struct cell* make_prim(FUNCTION* fun)
  ****************************************/
 struct cell* make_record(struct cell* type, struct cell* vector)
 {
-	struct cell* r = pop_cons();
+	struct cell* r = pop_cons_holding(type, vector, NULL);
 	r->type = RECORD;
 	r->car = type;
 	require(type->cdr->value == vector->value, "mes_cell.c: make_record received vector of wrong length\n");
@@ -735,10 +2784,14 @@ struct cell* make_record(struct cell* type, struct cell* vector)
  **********************************************/
  struct cell* make_record_type(char* name, struct cell* list)
 {
+	push_cell(list);
 	struct cell* r = pop_cons();
 	r->type = RECORD_TYPE;
 	r->string = name;
+	push_cell(r);
 	r->cdr = list_to_vector(list);
+	pop_cell();
+	pop_cell();
 	return r;
 }
 
@@ -756,8 +2809,48 @@ struct cell* make_record(struct cell* type, struct cell* vector)
 	return c;
 }
 
+struct cell* cell_invoke_fixed(struct cell* cell, struct cell* a, struct cell* b, struct cell* c)
+{
+	int arity = cell->cdr->value;
+// /*
+#if __MESC__
+	struct cell* (*fp1)(struct cell*) = cell->fixed;
+	struct cell* (*fp2)(struct cell*, struct cell*) = cell->fixed;
+	struct cell* (*fp3)(struct cell*, struct cell*, struct cell*) = cell->fixed;
+#else
+// */
+	FUNCTION* fp1 = cell->fixed;
+	FUNCTION* fp2 = cell->fixed;
+	FUNCTION* fp3 = cell->fixed;
+#endif
+	if(1 == arity) return fp1(a);
+	else if(2 == arity) return fp2(a, b);
+	return fp3(a, b, c);
+}
+
 struct cell* cell_invoke_function(struct cell* cell, struct cell* vals)
 {
+	/* Only a FIXED entry, so spread the list over its arguments */
+	if(NULL == cell->function)
+	{
+		struct cell* a = NULL;
+		struct cell* b = NULL;
+		struct cell* c = NULL;
+		int n = 0;
+		while(nil != vals)
+		{
+			require(CONS == vals->type, "primitive received an improper argument list\n");
+			require(n < cell->cdr->value, "primitive received too many arguments\n");
+			if(0 == n) a = vals->car;
+			else if(1 == n) b = vals->car;
+			else c = vals->car;
+			n = n + 1;
+			vals = vals->cdr;
+		}
+		require(n == cell->cdr->value, "primitive received too few arguments\n");
+		return cell_invoke_fixed(cell, a, b, c);
+	}
+
 // /*
 #if __MESC__
 	struct cell* (*fp)(struct cell*) = cell->function;
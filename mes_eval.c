@@ -26,20 +26,327 @@ struct cell* make_proc(struct cell* a, struct cell* b, struct cell* env);
 struct cell* reverse_list(struct cell* head);
 struct cell* string_eq(struct cell* a, struct cell* b);
 struct cell* vector_equal(struct cell* a, struct cell* b);
+struct cell* cell_invoke_fixed(struct cell* cell, struct cell* a, struct cell* b, struct cell* c);
 struct cell* cell_invoke_function(struct cell* cell, struct cell* vals);
+struct cell* forward_cell(struct cell* c);
+char* copy_string(char* target, char* source, int length);
+char* pop_string(unsigned size);
+int string_size(char* a);
+struct cell* make_sym(char* name);
 
 
 /* Support functions */
+
+/****************************************
+ * all_symbols is also kept hashed by   *
+ * name, so reading a symbol does not   *
+ * walk every symbol there is; a SYM    *
+ * holds its index plus one (in its     *
+ * LENGTH). For each symbol the table   *
+ * also remembers the binding it has in *
+ * g_symbols_env and how deep in it     *
+ * that binding is, for as long as its  *
+ * epoch matches globals_epoch.         *
+ * Anything but extend_global_env       *
+ * changing g_env bumps the epoch,      *
+ * which forgets them all.              *
+ ****************************************/
+struct cell** symbol_table;
+struct cell** symbol_globals;
+unsigned* symbol_depths;
+unsigned* symbol_epochs;
+unsigned symbol_table_size;
+unsigned symbol_count;
+unsigned globals_epoch;
+
+/****************************************
+ * The cells of g_symbols_env, bottom   *
+ * first; each of them also holds its   *
+ * index plus one (in its LENGTH) so an *
+ * environment that reaches one of them *
+ * can tell it is in g_symbols_env.     *
+ ****************************************/
+struct cell** global_spine;
+unsigned global_spine_size;
+unsigned global_depth;
+
+unsigned hash_name(char* name)
+{
+	unsigned h = 5381;
+	while(0 != name[0])
+	{
+		h = (h * 33) + name[0];
+		name = name + 1;
+	}
+
+	/* Names like s1 s2 s3 hash to neighbours, which probing hates */
+	h = h * 73244475;
+	return h ^ (h >> 16);
+}
+
+/* Where name is in the table, or the empty slot where it would go */
+unsigned symbol_slot(char* name)
+{
+	unsigned mask = symbol_table_size - 1;
+	unsigned i = hash_name(name) & mask;
+	char* s;
+	while(NULL != symbol_table[i])
+	{
+		s = symbol_table[i]->car->string;
+		if((s == name) || match(s, name)) return i;
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+void grow_symbol_table()
+{
+	struct cell** old = symbol_table;
+	unsigned old_size = symbol_table_size;
+	if(0 == symbol_table_size) symbol_table_size = 1024;
+	else symbol_table_size = symbol_table_size * 2;
+	symbol_table = calloc(symbol_table_size, sizeof(struct cell*));
+	symbol_globals = calloc(symbol_table_size, sizeof(struct cell*));
+	symbol_depths = calloc(symbol_table_size, sizeof(unsigned));
+	symbol_epochs = calloc(symbol_table_size, sizeof(unsigned));
+	require(NULL != symbol_epochs, "mes_eval.c: out of memory growing the symbol table\n");
+	globals_epoch = globals_epoch + 1;
+
+	unsigned i;
+	unsigned j;
+	for(i = 0; i < old_size; i = i + 1)
+	{
+		if(NULL != old[i])
+		{
+			j = symbol_slot(old[i]->car->string);
+			symbol_table[j] = old[i];
+			old[i]->car->length = j + 1;
+		}
+	}
+}
+
 struct cell* findsym(char *name)
 {
-	struct cell* symlist;
-	for(symlist = all_symbols; nil != symlist; symlist = symlist->cdr)
+	if(0 == symbol_count) return nil;
+	unsigned i = symbol_slot(name);
+	if(NULL == symbol_table[i]) return nil;
+	return symbol_table[i];
+}
+
+void add_symbol(struct cell* sym)
+{
+	all_symbols = make_cons(sym, all_symbols);
+	if((2 * (symbol_count + 1)) > symbol_table_size) grow_symbol_table();
+	unsigned i = symbol_slot(sym->string);
+	require(NULL == symbol_table[i], "mes_eval.c: symbol interned twice\n");
+	symbol_count = symbol_count + 1;
+	symbol_table[i] = all_symbols;
+	sym->length = i + 1;
+
+	/* Nothing can be bound to a symbol that did not exist yet */
+	symbol_globals[i] = nil;
+	symbol_depths[i] = 0;
+	symbol_epochs[i] = globals_epoch;
+}
+
+/****************************************
+ * The one SYM named name, made if need *
+ * be. A new SYM gets its own copy of   *
+ * name, as a STRING can be changed by  *
+ * string-set! and the table is keyed   *
+ * on the name.                         *
+ ****************************************/
+struct cell* intern(char* name)
+{
+	struct cell* r = findsym(name);
+	if(nil != r) return r->car;
+
+	/* Symbols may only point to the start of what pop_string gave us */
+	int size = string_size(name);
+	char* s = pop_string(size + 1);
+	copy_string(s, name, size);
+	r = make_sym(s);
+	add_symbol(r);
+	return r;
+}
+
+/* define-macro changed g_env in place, so count it again */
+void forget_globals()
+{
+	g_symbols_env = NULL;
+	global_depth = 0;
+}
+
+/* Where key is in the table, or symbol_table_size if it is not an interned SYM */
+unsigned symbol_index(struct cell* key)
+{
+	if(SYM != key->type) return symbol_table_size;
+	if(0 == key->length) return symbol_table_size;
+	return key->length - 1;
+}
+
+void grow_global_spine(unsigned size)
+{
+	if(size <= global_spine_size) return;
+	struct cell** old = global_spine;
+	global_spine_size = (size * 2) + 1024;
+	global_spine = calloc(global_spine_size, sizeof(struct cell*));
+	require(NULL != global_spine, "mes_eval.c: out of memory growing the global spine\n");
+	unsigned i;
+	for(i = 0; i < global_depth; i = i + 1) global_spine[i] = old[i];
+}
+
+void push_global_spine(struct cell* c)
+{
+	grow_global_spine(global_depth + 1);
+	global_spine[global_depth] = c;
+	global_depth = global_depth + 1;
+	c->length = global_depth;
+}
+
+/****************************************
+ * Make g_symbols_env g_env again. When *
+ * g_env is only further down the one   *
+ * we had (let and friends restoring    *
+ * it) the spine just gets shorter;     *
+ * otherwise it is counted afresh.      *
+ ****************************************/
+void sync_globals()
+{
+	if(g_env == g_symbols_env) return;
+	globals_epoch = globals_epoch + 1;
+	g_symbols_env = g_env;
+	if(nil == g_env)
+	{
+		global_depth = 0;
+		return;
+	}
+
+	unsigned d = g_env->length;
+	if((0 != d) && (d <= global_depth))
+	{
+		if(g_env == global_spine[d - 1])
+		{
+			global_depth = d;
+			return;
+		}
+	}
+
+	struct cell* i;
+	d = 0;
+	for(i = g_env; nil != i; i = i->cdr) d = d + 1;
+	global_depth = 0;
+	grow_global_spine(d);
+	global_depth = d;
+	for(i = g_env; nil != i; i = i->cdr)
+	{
+		global_spine[d - 1] = i;
+		i->length = d;
+		d = d - 1;
+	}
+}
+
+/* Compacting moved all_symbols and the bindings */
+void forward_symbol_table()
+{
+	unsigned i;
+	for(i = 0; i < symbol_table_size; i = i + 1)
+	{
+		if(NULL != symbol_table[i]) symbol_table[i] = forward_cell(symbol_table[i]);
+	}
+	for(i = 0; i < global_depth; i = i + 1) global_spine[i] = forward_cell(global_spine[i]);
+	globals_epoch = globals_epoch + 1;
+}
+
+
+/* Walk g_env for what key (at i in the table) is bound to there */
+void lookup_global(struct cell* key, unsigned i)
+{
+	struct cell* r = nil;
+	struct cell* c;
+	for(c = g_env; nil != c; c = c->cdr)
 	{
-		if(match(name, symlist->car->string))
+		if(c->car->car->string == key->string)
 		{
-			return symlist;
+			r = c->car;
+			break;
 		}
 	}
+
+	symbol_globals[i] = r;
+	if(nil != r) symbol_depths[i] = c->length;
+	symbol_epochs[i] = globals_epoch;
+}
+
+
+/****************************************
+ * The binding key has in g_env (or nil *
+ * if it has none), found by walking    *
+ * g_env only the first time it is      *
+ * asked for since g_env last changed.  *
+ * NULL if key is not an interned SYM.  *
+ ****************************************/
+struct cell* global_binding(struct cell* key)
+{
+	unsigned i = symbol_index(key);
+	if(symbol_table_size == i) return NULL;
+	if(g_env != g_symbols_env) sync_globals();
+	if(globals_epoch != symbol_epochs[i]) lookup_global(key, i);
+	return symbol_globals[i];
+}
+
+
+/****************************************
+ * Bind sym at the front of g_env, as   *
+ * define does; which only changes what *
+ * sym itself is bound to, so the rest  *
+ * of the table stays good.             *
+ ****************************************/
+void extend_global_env(struct cell* sym, struct cell* value)
+{
+	sync_globals();
+	g_env = make_cons(make_cons(sym, value), g_env);
+	g_symbols_env = g_env;
+	push_global_spine(g_env);
+
+	unsigned i = symbol_index(sym);
+	if(symbol_table_size == i) return;
+	symbol_globals[i] = g_env->car;
+	symbol_depths[i] = global_depth;
+	symbol_epochs[i] = globals_epoch;
+}
+
+
+/****************************************
+ * Walk the alist comparing the string  *
+ * pointers, which is enough as every   *
+ * SYM is interned. Once we get to a    *
+ * cell of g_env, what key is bound to  *
+ * from there on down is just what      *
+ * g_env binds it to; unless something  *
+ * above that cell rebinds key, in      *
+ * which case we keep walking.          *
+ ****************************************/
+struct cell* find_binding(struct cell* key, struct cell* alist)
+{
+	unsigned k = symbol_index(key);
+	unsigned d;
+	struct cell* i;
+	for(i = alist; nil != i; i = i->cdr)
+	{
+		d = i->length;
+		if((0 != d) && (symbol_table_size != k))
+		{
+			if(g_env != g_symbols_env) sync_globals();
+			if((d <= global_depth) && (i == global_spine[d - 1]))
+			{
+				if(globals_epoch != symbol_epochs[k]) lookup_global(key, k);
+				if(nil == symbol_globals[k]) return nil;
+				if(symbol_depths[k] <= d) return symbol_globals[k];
+			}
+		}
+		if(i->car->car->string == key->string) return i->car;
+	}
 	return nil;
 }
 
@@ -56,45 +363,30 @@ struct cell* findsym(char *name)
  *  V                                   *
  * SYM -> TEXT                          *
  *                                      *
- * Because efforts are used to leverage *
- * The same string for all symbols, we  *
- * can usually cheat and just compare   *
- * the string pointers themselves       *
- * (FAST) and if that fails, we perform *
- * a last ditch (SLOW) lookup, which    *
- * actually compares the contents of    *
- * the strings themselves.              *
+ * As all symbols are interned we can   *
+ * just compare the string pointers     *
+ * themselves; and g_env itself is      *
+ * looked up in the symbol table.       *
  ***************************************/
 struct cell* assoc(struct cell* key, struct cell* alist)
 {
 	if(nil == alist) return nil;
-	struct cell* i;
-	for(i = alist; nil != i; i = i->cdr)
+	struct cell* r;
+	if(alist == g_env)
 	{
-		if(i->car->car->string == key->string) return i->car;
+		r = global_binding(key);
+		if(NULL != r) return r;
 	}
 
-	/* Last ditch effort (REALLY SLOW)*/
-	if(SYM != key->type) return nil;
-	for(i = alist; nil != i; i = i->cdr)
-	{
-		if(SYM == i->car->car->type)
-		{
-			if(match(i->car->car->string, key->string)) return i->car;
-		}
-	}
+	r = find_binding(key, alist);
+	if(nil != r) return r;
 
 	/* Pray we are in a lambda */
 	if(NULL == R4) return nil;
 	require(CONS == R4->type, "Looks like R4 isn't a list\nAbort before we damage something\n");
-	for(i = g_env; nil != i; i = i->cdr)
-	{
-		if(SYM == i->car->car->type)
-		{
-			if(match(i->car->car->string, key->string)) return i->car;
-		}
-	}
-	return nil;
+	r = global_binding(key);
+	if(NULL == r) return nil;
+	return r;
 }
 
 
@@ -145,14 +437,95 @@ void evlis()
 	R0 = R0->car;
 	eval();
 	R0 = pop_cell();
-	struct cell* i = R1;
 	g_env = pop_cell();
+
+	/* Keep what we have evaluated so far safe while we evaluate the rest */
+	push_cell(R1);
 	evlis();
 	struct cell* j = R1;
+	struct cell* i = pop_cell();
 	R1 = make_cons(i, j);
 }
 
 
+/****************************************
+ * A PRIMOP with a declared ARITY takes *
+ * its arguments directly, so when R0   *
+ * holds exactly that many they are     *
+ * evaluated onto g_stack, which keeps  *
+ * them safe, rather than consed into a *
+ * list by evlis. Returns FALSE without *
+ * evaluating anything otherwise.       *
+ ****************************************/
+int eval_fixed(struct cell* proc)
+{
+	int arity = proc->cdr->value;
+	int n = 0;
+	struct cell* i;
+	for(i = R0; (CONS == i->type) && (n <= arity); i = i->cdr) n = n + 1;
+	if((n != arity) || (nil != i)) return FALSE;
+
+	push_cell(proc);
+	int frame = stack_pointer;
+	while(nil != R0)
+	{
+		push_cell(g_env);
+		push_cell(R0->cdr);
+		R0 = R0->car;
+		eval();
+		R0 = pop_cell();
+		g_env = pop_cell();
+		push_cell(R1);
+	}
+
+	g_applications = g_applications + 1;
+	if(1 == arity) R1 = cell_invoke_fixed(proc, g_stack[frame], NULL, NULL);
+	else if(2 == arity) R1 = cell_invoke_fixed(proc, g_stack[frame], g_stack[frame + 1], NULL);
+	else R1 = cell_invoke_fixed(proc, g_stack[frame], g_stack[frame + 1], g_stack[frame + 2]);
+
+	while(frame <= stack_pointer) pop_cell();
+	return TRUE;
+}
+
+
+void eval();
+/****************************************
+ * Evaluate the list of s-expressions   *
+ * in R0 in order, but for the last     *
+ * which is left in R0 for the caller   *
+ * to evaluate in tail position; the    *
+ * body of a begin and of every LAMBDA  *
+ * applied.                             *
+ ****************************************/
+void eval_body()
+{
+	/* Protect against (begin) statements */
+	require(nil != R0, "sequence of zero expressions in form (begin)\n");
+
+	/* Catch a naked begin */
+	require(CONS == R0->type, "naked begin is not supported\n");
+
+	/* Loop through s-expressions until the last */
+	while(nil != R0->cdr)
+	{
+		/* make sure it is a proper list */
+		require(CONS == R0->cdr->type, "you managed to pass begin without a nil terminated list\n");
+
+		/* Protect the rest of the list */
+		push_cell(R0->cdr);
+
+		/* Evaluate current leading s-expression */
+		R0 = R0->car;
+		eval();
+
+		/* Move to next s-expression*/
+		R0 = pop_cell();
+	}
+
+	R0 = R0->car;
+}
+
+
 /****************************************
  * apply is a seperate function because *
  * honestly, I like it better that way  *
@@ -164,15 +537,23 @@ void evlis()
  * and vals -> R1 if we run into some   *
  * craziness like garbage collection    *
  * being called between apply and eval  *
+ *                                      *
+ * For a LAMBDA it stops short of the   *
+ * last expression of the body, leaving *
+ * it in R0 and returning TRUE, so that *
+ * eval can make the tail call without  *
+ * growing either stack.                *
  ****************************************/
-void apply(struct cell* proc, struct cell* vals)
+int tail_apply(struct cell* proc, struct cell* vals, int owned)
 {
 	struct cell* syms;
+	struct cell* binding;
+	g_applications = g_applications + 1;
 	if(proc->type == PRIMOP)
 	{
 		/* Deal with the simple case of if we have a primitive */
 		R1 = cell_invoke_function(proc, vals);
-		return;
+		return FALSE;
 	}
 	else if(proc->type == LAMBDA)
 	{
@@ -190,9 +571,9 @@ void apply(struct cell* proc, struct cell* vals)
 		 * forward references, I haven't        *
 		 * figured out yet.                     *
 		 ****************************************/
-		push_cell(R4);
 		R4 = proc->env;
 		syms = proc->car;
+		if(owned) R1 = vals;
 
 		/* extend the locals*/
 		while(nil != syms)
@@ -207,18 +588,41 @@ void apply(struct cell* proc, struct cell* vals)
 			}
 			else
 			{
-				/* Support common case of just mapping of a to 4 in (define (foo a b ..)); (foo 4 5 ..) */
-				R4 = make_cons(make_cons(syms->car, vals->car), R4);
-				syms = syms->cdr;
-				vals = vals->cdr;
+				require(nil != vals, "too few arguments to lambda\n");
+				require(CONS == vals->type, "lambda arguments are not a proper list\n");
+				if(owned)
+				{
+					/****************************************
+					 * Nobody else has seen the list evlis  *
+					 * built, so (value . rest) can become  *
+					 * ((sym . value) . locals) in place,   *
+					 * allocating one cell per local rather *
+					 * than two. R1 keeps the rest safe.    *
+					 ****************************************/
+					binding = R1;
+					R1 = R1->cdr;
+					binding->cdr = R4;
+					R4 = binding;
+					gc_write_barrier(binding);
+					binding->car = make_cons(syms->car, binding->car);
+					gc_write_barrier(binding);
+					syms = syms->cdr;
+					vals = R1;
+				}
+				else
+				{
+					/* Support common case of just mapping of a to 4 in (define (foo a b ..)); (foo 4 5 ..) */
+					R4 = make_cons(make_cons(syms->car, vals->car), R4);
+					syms = syms->cdr;
+					vals = vals->cdr;
+				}
 			}
 			require(NULL != syms, "(lambda foo ... expressions are not valid scheme\n");
 		}
 
-		R0 = make_cons(s_begin, proc->cdr);
-		eval();
-		R4 = pop_cell();
-		return;
+		R0 = proc->cdr;
+		eval_body();
+		return TRUE;
 	}
 	file_print("Bad argument to apply: ", stderr);
 	require(SYM == proc->type, "{ERROR} unable to print string name\n");
@@ -227,6 +631,30 @@ void apply(struct cell* proc, struct cell* vals)
 	exit(EXIT_FAILURE);
 }
 
+/* apply for those that are not eval, and so need the value now */
+void apply(struct cell* proc, struct cell* vals, int owned)
+{
+	push_cell(R4);
+	if(tail_apply(proc, vals, owned)) eval();
+	R4 = pop_cell();
+}
+
+
+/****************************************
+ * Evaluate R0 into R1.                 *
+ *                                      *
+ * Whatever is in tail position (the    *
+ * branches of if, the last expression  *
+ * of a body and the like) is not       *
+ * evaluated by recursing but by going  *
+ * back to tail_call with it in R0, so  *
+ * that loops written as tail calls run *
+ * in constant C stack and g_stack. A   *
+ * tail call to a LAMBDA replaces R4    *
+ * with its own locals; ours are kept   *
+ * on g_stack (only the first time) and *
+ * come back once we are done.          *
+ ****************************************/
 void eval()
 {
 	if(SYM == R0->type)
@@ -248,501 +676,535 @@ void eval()
 		R1 = R1->cdr;
 		return;
 	}
-	else if(CONS == R0->type)
+
+	/* Fall through case */
+	if(CONS != R0->type)
+	{
+		R1 = R0;
+		return;
+	}
+
+	/* Set once a tail call is about to replace R4 with its locals */
+	int saved = FALSE;
+	int syntax;
+
+tail_call:
+	/* A tail call to an atom */
+	if(CONS != R0->type)
 	{
-		if(R0->car == s_if)
-		{
-			require(nil != R0->cdr, "naked if statement is not a valid s-expression\n");
-			/* Evaluate the conditional */
-			push_cell(R0);
-			R0 = R0->cdr->car;
-			eval();
-			R0 = pop_cell();
+		eval();
+		goto eval_done;
+	}
 
-			/* Execute if not false because that is what guile does (believe everything not #f is true) */
-			if(R1 != cell_f)
-			{
-				R0 = R0->cdr->cdr->car;
-				eval();
-				return;
-			}
+	/* Plain applications need not look at the special forms at all */
+	if(SYM != R0->car->type) goto application;
+	if(NULL == R0->car->cdr) goto application;
+	syntax = R0->car->cdr->value;
 
-			/* If there is no ELSE statement do as guile does */
-			if(nil == R0->cdr->cdr->cdr)
-			{
-				R1 = cell_unspecified;
-				return;
-			}
+	if(SYNTAX_IF == syntax)
+	{
+		require(nil != R0->cdr, "naked if statement is not a valid s-expression\n");
+		/* Evaluate the conditional */
+		push_cell(R0);
+		R0 = R0->cdr->car;
+		eval();
+		R0 = pop_cell();
 
-			/* Just do the ELSE s-expression */
-			R0 = R0->cdr->cdr->cdr->car;
-			eval();
-			return;
+		/* Execute if not false because that is what guile does (believe everything not #f is true) */
+		if(R1 != cell_f)
+		{
+			R0 = R0->cdr->cdr->car;
+			goto tail_call;
 		}
-		else if(R0->car == s_or)
+
+		/* If there is no ELSE statement do as guile does */
+		if(nil == R0->cdr->cdr->cdr)
 		{
-			/* Move past or */
-			R0 = R0->cdr;
+			R1 = cell_unspecified;
+			goto eval_done;
+		}
 
-			while(nil != R0)
-			{
-				push_cell(R0);
-				R0 = R0->car;
-				eval();
-				R0 = pop_cell();
-				if(cell_f != R1) return;
-				R0 = R0->cdr;
-			}
+		/* Just do the ELSE s-expression */
+		R0 = R0->cdr->cdr->cdr->car;
+		goto tail_call;
+	}
+	else if(SYNTAX_OR == syntax)
+	{
+		/* Move past or */
+		R0 = R0->cdr;
+		R1 = cell_f;
+		if(nil == R0) goto eval_done;
 
-			R1 = cell_f;
-			return;
-		}
-		else if(R0->car == s_and)
+		/* The last one is in tail position */
+		while(nil != R0->cdr)
 		{
-			/* Move past and */
+			push_cell(R0);
+			R0 = R0->car;
+			eval();
+			R0 = pop_cell();
+			if(cell_f != R1) goto eval_done;
 			R0 = R0->cdr;
-			/* Assume true by default */
-			R1 = cell_t;
-			while(nil != R0)
-			{
-				push_cell(R0);
-				R0 = R0->car;
-				eval();
-				R0 = pop_cell();
-				if(cell_f == R1) break;
-				R0 = R0->cdr;
-			}
-			return;
 		}
-		else if(R0->car == s_when)
+
+		R0 = R0->car;
+		goto tail_call;
+	}
+	else if(SYNTAX_AND == syntax)
+	{
+		/* Move past and */
+		R0 = R0->cdr;
+		/* Assume true by default */
+		R1 = cell_t;
+		if(nil == R0) goto eval_done;
+
+		/* The last one is in tail position */
+		while(nil != R0->cdr)
 		{
-			require(nil != R0->cdr, "naked when statement is not a valid s-expression\n");
-			/* Evaluate the conditional */
 			push_cell(R0);
-			R0 = R0->cdr->car;
+			R0 = R0->car;
 			eval();
 			R0 = pop_cell();
+			if(cell_f == R1) goto eval_done;
+			R0 = R0->cdr;
+		}
 
-			/* Execute if not false because that is what guile does (believe everything not #f is true) */
-			if(R1 != cell_f)
-			{
-				R0 = R0->cdr->cdr->car;
-				eval();
-				return;
-			}
+		R0 = R0->car;
+		goto tail_call;
+	}
+	else if(SYNTAX_WHEN == syntax)
+	{
+		require(nil != R0->cdr, "naked when statement is not a valid s-expression\n");
+		/* Evaluate the conditional */
+		push_cell(R0);
+		R0 = R0->cdr->car;
+		eval();
+		R0 = pop_cell();
 
-			/* Just do what guile does */
-			R1 = cell_unspecified;
-			return;
-		}
-		else if(R0->car == s_cond)
+		/* Execute if not false because that is what guile does (believe everything not #f is true) */
+		if(R1 != cell_f)
 		{
-			/* Get past the COND */
-			R0 = R0->cdr;
+			R0 = R0->cdr->cdr->car;
+			goto tail_call;
+		}
 
-			/* Provide a way to flag no fields in cond */
-			R1 = NULL;
+		/* Just do what guile does */
+		R1 = cell_unspecified;
+		goto eval_done;
+	}
+	else if(SYNTAX_COND == syntax)
+	{
+		/* Get past the COND */
+		R0 = R0->cdr;
 
-			/* Loop until end of list of s-expressions */
-			while(nil != R0)
-			{
-				/* Protect remaining list of s-expressions from garbage collection */
-				push_cell(R0);
+		/* Provide a way to flag no fields in cond */
+		R1 = NULL;
 
-				/* Evaluate the conditional */
-				R0 = R0->car->car;
-				eval();
-				R0 = pop_cell();
-
-				/* Execute if not false because that is what guile does (believe everything not #f is true) */
-				if(cell_f != R1)
-				{
-					R0 = make_cons(s_begin, R0->car->cdr);
-					eval();
-					return;
-				}
+		/* Loop until end of list of s-expressions */
+		while(nil != R0)
+		{
+			/* Protect remaining list of s-expressions from garbage collection */
+			push_cell(R0);
 
-				/* Iterate to the next in the list of s-expressions */
-				R0 = R0->cdr;
+			/* Evaluate the conditional */
+			R0 = R0->car->car;
+			eval();
+			R0 = pop_cell();
 
-				/* The default return in guile if it hits nil */
-				R1 = cell_unspecified;
+			/* Execute if not false because that is what guile does (believe everything not #f is true) */
+			if(cell_f != R1)
+			{
+				R0 = R0->car->cdr;
+				eval_body();
+				goto tail_call;
 			}
 
-			require(NULL != R1, "a naked cond is not supported\n");
-			return;
+			/* Iterate to the next in the list of s-expressions */
+			R0 = R0->cdr;
+
+			/* The default return in guile if it hits nil */
+			R1 = cell_unspecified;
 		}
-		else if(R0->car == s_case)
-		{
-			/* Protect against (case) statements */
-			require(nil != R0->cdr, "source expression (case) failed to match any pattern in form (case)\n");
 
-			/* Get past the CASE */
-			R0 = R0->cdr;
+		require(NULL != R1, "a naked cond is not supported\n");
+		goto eval_done;
+	}
+	else if(SYNTAX_CASE == syntax)
+	{
+		/* Protect against (case) statements */
+		require(nil != R0->cdr, "source expression (case) failed to match any pattern in form (case)\n");
 
-			/* Provide a way to flag no fields in case */
-			R1 = NULL;
+		/* Get past the CASE */
+		R0 = R0->cdr;
 
-			/* Protect the value we are casing after */
-			push_cell(R4);
-			push_cell(R0->cdr);
-			R0 = R0->car;
-			eval();
-			R4 = R1;
-			R0 = pop_cell();
+		/* Provide a way to flag no fields in case */
+		R1 = NULL;
+
+		/* Protect the value we are casing after */
+		push_cell(R4);
+		push_cell(R0->cdr);
+		R0 = R0->car;
+		eval();
+		R4 = R1;
+		R0 = pop_cell();
 
-			/* Loop until end of list of s-expressions */
-			while(nil != R0)
+		/* Loop until end of list of s-expressions */
+		while(nil != R0)
+		{
+			require(CONS == R0->car->type, "Missing ( in case\n");
+			R1 = cell_f;
+			if(s_else == R0->car->car)
 			{
-				require(CONS == R0->car->type, "Missing ( in case\n");
-				R1 = cell_f;
-				if(s_else == R0->car->car)
-				{
-					R1 = cell_t;
-				}
-				else
+				R1 = cell_t;
+			}
+			else
+			{
+				/* now walk the list of values */
+				require(CONS == R0->car->car->type, "only ((..) ..) form accepted in case statements\n");
+				push_cell(R3);
+				R3 = R0->car->car;
+				while(nil != R3)
 				{
-					/* now walk the list of values */
-					require(CONS == R0->car->car->type, "only ((..) ..) form accepted in case statements\n");
-					push_cell(R3);
-					R3 = R0->car->car;
-					while(nil != R3)
+					R1 = R3->car;
+					if(R4 == R1) R1 = cell_t;
+					else if(R4->type == R1->type)
 					{
-						R1 = R3->car;
-						if(R4 == R1) R1 = cell_t;
-						else if(R4->type == R1->type)
+						/* Approximate eqv? comparision */
+						if((INT == R4->type) || (CHAR == R4->type))
 						{
-							/* Approximate eqv? comparision */
-							if((INT == R4->type) || (CHAR == R4->type))
-							{
-								if(R4->value == R1->value) R1 = cell_t;
-								else R1 = cell_f;
-							}
-							else if(STRING == R4->type)
-							{
-								R1 = string_eq(R4, R1);
-							}
-							else if(VECTOR == R4->type)
-							{
-								R1 = vector_equal(R4, R1);
-							}
+							if(R4->value == R1->value) R1 = cell_t;
 							else R1 = cell_f;
 						}
+						else if(STRING == R4->type)
+						{
+							R1 = string_eq(R4, R1);
+						}
+						else if(VECTOR == R4->type)
+						{
+							R1 = vector_equal(R4, R1);
+						}
 						else R1 = cell_f;
-
-						if(cell_t == R1) break;
-						R3 = R3->cdr;
 					}
-					R3 = pop_cell();
-				}
+					else R1 = cell_f;
 
-				if(cell_f != R1)
-				{
-					R4 = pop_cell();
-					R0 = make_cons(s_begin, R0->car->cdr);
-					eval();
-					return;
+					if(cell_t == R1) break;
+					R3 = R3->cdr;
 				}
-				R0 = R0->cdr;
+				R3 = pop_cell();
 			}
 
-			require(NULL != R1, "a naked case is not supported\n");
-			R4 = pop_cell();
-			return;
-		}
-		else if(R0->car == s_lambda)
-		{
-			if(NULL != R4)
+			if(cell_f != R1)
 			{
-				R1 = make_proc(R0->cdr->car, R0->cdr->cdr, make_cons(R4->car, R4->cdr));
-			}
-			else
-			{
-				/* (lambda (a b .. N) (s-expression)) */
-				R1 = make_proc(R0->cdr->car, R0->cdr->cdr, make_cons(g_env->car, g_env->cdr));
+				R4 = pop_cell();
+				R0 = R0->car->cdr;
+				eval_body();
+				goto tail_call;
 			}
-			return;
+			R0 = R0->cdr;
 		}
-		else if(R0->car == quote)
-		{
-			/* Protect against (quote) statements */
-			require(nil != R0->cdr, "quote: bad syntax in form (quote)\n");
 
-			/* (quote (...)) */
-			R1 = R0->cdr->car;
-			return;
+		require(NULL != R1, "a naked case is not supported\n");
+		R4 = pop_cell();
+		goto eval_done;
+	}
+	else if(SYNTAX_LAMBDA == syntax)
+	{
+		if(NULL != R4)
+		{
+			R1 = make_proc(R0->cdr->car, R0->cdr->cdr, make_cons(R4->car, R4->cdr));
 		}
-		else if(R0->car == quasiquote)
+		else
 		{
-			/* Protect against (quasiquote) statements */
-			require(nil != R0->cdr, "source expression (quasiquote) failed to match any pattern in form (quasiquote)\n");
+			/* (lambda (a b .. N) (s-expression)) */
+			R1 = make_proc(R0->cdr->car, R0->cdr->cdr, make_cons(g_env->car, g_env->cdr));
+		}
+		goto eval_done;
+	}
+	else if(SYNTAX_QUOTE == syntax)
+	{
+		/* Protect against (quote) statements */
+		require(nil != R0->cdr, "quote: bad syntax in form (quote)\n");
 
-			/* Protect the s-expression during the entire evaluation */
-			push_cell(R0);
-			/* R2 is the s-expression we are quasiquoting */
-			push_cell(R2);
-			/* R3 is the resulting s-expression, built backwards and reversed at the end */
-			push_cell(R3);
-			/* R4 is just a temp holder of each unquote */
-			push_cell(R4);
+		/* (quote (...)) */
+		R1 = R0->cdr->car;
+		goto eval_done;
+	}
+	else if(SYNTAX_QUASIQUOTE == syntax)
+	{
+		/* Protect against (quasiquote) statements */
+		require(nil != R0->cdr, "source expression (quasiquote) failed to match any pattern in form (quasiquote)\n");
+
+		/* Protect the s-expression during the entire evaluation */
+		push_cell(R0);
+		/* R2 is the s-expression we are quasiquoting */
+		push_cell(R2);
+		/* R3 is the resulting s-expression, built backwards and reversed at the end */
+		push_cell(R3);
+		/* R4 is just a temp holder of each unquote */
+		push_cell(R4);
 
-			/* (quasiquote (...)) */
-			R2 = R0->cdr->car;
-			R3 = NULL;
-			while(nil != R2)
+		/* (quasiquote (...)) */
+		R2 = R0->cdr->car;
+		R3 = NULL;
+		while(nil != R2)
+		{
+			require(NULL != R2, "Null in quasiquote expression reached\n");
+			require(CONS == R2->type, "Not a cons list in quasiquote reached\n");
+			R4 = R2->car;
+			if(CONS == R2->car->type)
 			{
-				require(NULL != R2, "Null in quasiquote expression reached\n");
-				require(CONS == R2->type, "Not a cons list in quasiquote reached\n");
-				R4 = R2->car;
-				if(CONS == R2->car->type)
+				if(unquote == R2->car->car)
 				{
-					if(unquote == R2->car->car)
+					R0 = R2->car->cdr->car;
+					R4 = NULL; /* So that assoc doesn't mistake this for a lambda */
+					push_cell(R3);
+					push_cell(R2);
+					eval();
+					R2 = pop_cell();
+					R3 = pop_cell();
+					R4 = R1;
+				}
+				if(unquote_splicing == R2->car->car)
+				{
+					R0 = R2->car->cdr->car;
+					push_cell(R4);
+					push_cell(R3);
+					push_cell(R2);
+					R4 = NULL; /* So that assoc doesn't mistake this for a lambda */
+					eval();
+					R2 = pop_cell();
+					R3 = pop_cell();
+					R4 = pop_cell();
+					while((NULL != R1) && (nil != R1))
 					{
-						R0 = R2->car->cdr->car;
-						R4 = NULL; /* So that assoc doesn't mistake this for a lambda */
-						push_cell(R3);
-						push_cell(R2);
-						eval();
-						R2 = pop_cell();
-						R3 = pop_cell();
-						R4 = R1;
+						/* Unsure if correct behavior is to revert to unquote behavior (what guile does) */
+						/* Or restrict to just proper lists as the spec (r7rs) requires */
+						/* eg. `(foo bar ,@(+ 4 5)) */
+						require(CONS == R1->type, "unquote-splicing requires argument of type <proper list>\n");
+						R3 = make_cons(R1->car, R3);
+						/* Simply convert require to if and the above */
+						/* else R3 = make_cons(R1, R3); */
+						R1 = R1->cdr;
 					}
-					if(unquote_splicing == R2->car->car)
-					{
-						R0 = R2->car->cdr->car;
-						push_cell(R4);
-						push_cell(R3);
-						push_cell(R2);
-						R4 = NULL; /* So that assoc doesn't mistake this for a lambda */
-						eval();
-						R2 = pop_cell();
-						R3 = pop_cell();
-						R4 = pop_cell();
-						while((NULL != R1) && (nil != R1))
-						{
-							/* Unsure if correct behavior is to revert to unquote behavior (what guile does) */
-							/* Or restrict to just proper lists as the spec (r7rs) requires */
-							/* eg. `(foo bar ,@(+ 4 5)) */
-							require(CONS == R1->type, "unquote-splicing requires argument of type <proper list>\n");
-							R3 = make_cons(R1->car, R3);
-							/* Simply convert require to if and the above */
-							/* else R3 = make_cons(R1, R3); */
-							R1 = R1->cdr;
-						}
 
-						/* we really don't want to add that cons after what we just did */
-						goto restart_quasiquote;
-					}
+					/* we really don't want to add that cons after what we just did */
+					goto restart_quasiquote;
 				}
-				R3 = make_cons(R4, R3);
-restart_quasiquote:
-				/* keep walking down the list of s-expressions */
-				R2 = R2->cdr;
 			}
+			R3 = make_cons(R4, R3);
+restart_quasiquote:
+			/* keep walking down the list of s-expressions */
+			R2 = R2->cdr;
+		}
 
-			/* We created the list backwards because it was simpler, now we have to put it into correct order */
-			R2 = R3;
-			R3 = reverse_list(R3);
-			require(NULL != R2, "Impossible quasiquote processed?\n");
-			R2->cdr = nil;
-			R1 = R3;
+		/* We created the list backwards because it was simpler, now we have to put it into correct order */
+		R2 = R3;
+		R3 = reverse_list(R3);
+		require(NULL != R2, "Impossible quasiquote processed?\n");
+		R2->cdr = nil;
+		R1 = R3;
 
-			/* We are finally done with the s-expression, we don't need it back */
+		/* We are finally done with the s-expression, we don't need it back */
+		R4 = pop_cell();
+		R3 = pop_cell();
+		R2 = pop_cell();
+		pop_cell();
+		goto eval_done;
+	}
+	else if(SYNTAX_DEFINE == syntax)
+	{
+		require(CONS == R0->cdr->type, "naked (define) not supported\n");
+
+		/* To support (define (foo a b .. N) (s-expression)) form */
+		if(CONS == R0->cdr->car->type)
+		{
+			/* R2 is to get the actual function*/
+			push_cell(R2);
+			/* R3 is to get the function arguments */
+			push_cell(R3);
+			/* R4 is to get the function's name */
+			push_cell(R4);
+			R2 = R0->cdr->cdr;
+			R3 = R0->cdr->car->cdr;
+			R4 = R0->cdr->car->car;
+			/* by converting it into (define foo (lambda (a b .. N) (s-expression))) form */
+			R0->cdr = make_cons(R4, make_cons(make_cons(s_lambda, make_cons(R3, R2)), nil));
+			gc_write_barrier(R0);
 			R4 = pop_cell();
 			R3 = pop_cell();
 			R2 = pop_cell();
-			pop_cell();
-			return;
 		}
-		else if(R0->car == s_define)
-		{
-			require(CONS == R0->cdr->type, "naked (define) not supported\n");
 
-			/* To support (define (foo a b .. N) (s-expression)) form */
-			if(CONS == R0->cdr->car->type)
-			{
-				/* R2 is to get the actual function*/
-				push_cell(R2);
-				/* R3 is to get the function arguments */
-				push_cell(R3);
-				/* R4 is to get the function's name */
-				push_cell(R4);
-				R2 = R0->cdr->cdr;
-				R3 = R0->cdr->car->cdr;
-				R4 = R0->cdr->car->car;
-				/* by converting it into (define foo (lambda (a b .. N) (s-expression))) form */
-				R0->cdr = make_cons(R4, make_cons(make_cons(s_lambda, make_cons(R3, R2)), nil));
-				R4 = pop_cell();
-				R3 = pop_cell();
-				R2 = pop_cell();
-			}
+		/* Protect the name from garbage collection */
+		push_cell(R0->cdr->car);
 
-			/* Protect the name from garbage collection */
-			push_cell(R0->cdr->car);
+		/* Evaluate the s-expression which the name is supposed to equal */
+		require(nil != R0->cdr->cdr, "naked (define foo) not supported\n");
+		R0 = R0->cdr->cdr->car;
+		push_cell(R4);
+		push_cell(R3);
+		push_cell(R2);
+		eval();
+		R2 = pop_cell();
+		R3 = pop_cell();
+		R4 = pop_cell();
+		R0 = pop_cell();
 
-			/* Evaluate the s-expression which the name is supposed to equal */
-			require(nil != R0->cdr->cdr, "naked (define foo) not supported\n");
-			R0 = R0->cdr->cdr->car;
-			push_cell(R4);
-			push_cell(R3);
-			push_cell(R2);
-			eval();
-			R2 = pop_cell();
-			R3 = pop_cell();
-			R4 = pop_cell();
-			R0 = pop_cell();
+		/* If we define a LAMBDA/MACRO, we need to extend its environment otherwise it can not call itself recursively */
+		if((LAMBDA == R1->type) || (MACRO == R1->type))
+		{
+			R1->env = make_cons(make_cons(R0, R1), R1->env);
+			gc_write_barrier(R1);
+		}
 
-			/* If we define a LAMBDA/MACRO, we need to extend its environment otherwise it can not call itself recursively */
-			if((LAMBDA == R1->type) || (MACRO == R1->type))
-			{
-				R1->env = make_cons(make_cons(R0, R1), R1->env);
-			}
+		/* We now need to extend the environment with our new name */
+		extend_global_env(R0, R1);
+		R1 = cell_unspecified;
+		goto eval_done;
+	}
+	else if(SYNTAX_SETB == syntax)
+	{
+		/* Protect against (set!) statements */
+		require(nil != R0->cdr, "bad set! in form (set!)\n");
 
-			/* We now need to extend the environment with our new name */
-			g_env = make_cons(make_cons(R0, R1), g_env);
-			R1 = cell_unspecified;
-			return;
-		}
-		else if(R0->car == s_setb)
-		{
-			/* Protect against (set!) statements */
-			require(nil != R0->cdr, "bad set! in form (set!)\n");
+		/* attempt to lookup the variable we are set! to a new value */
+		if(NULL != R4) R2 = assoc(R0->cdr->car, R4);
+		else R2 = assoc(R0->cdr->car, g_env);
 
-			/* attempt to lookup the variable we are set! to a new value */
-			if(NULL != R4) R2 = assoc(R0->cdr->car, R4);
-			else R2 = assoc(R0->cdr->car, g_env);
+		if(nil == R2)
+		{
+			file_print("Assigning value to unbound variable: ", stderr);
+			file_print(R0->cdr->car->string, stderr);
+			file_print("\nAborting to prevent problems\n", stderr);
+			exit(EXIT_FAILURE);
+		}
 
-			if(nil == R2)
-			{
-				file_print("Assigning value to unbound variable: ", stderr);
-				file_print(R0->cdr->car->string, stderr);
-				file_print("\nAborting to prevent problems\n", stderr);
-				exit(EXIT_FAILURE);
-			}
+		/* Protect target */
+		push_cell(R2);
 
-			/* Protect target */
-			push_cell(R2);
+		/* Get that new value */
+		R0 = R0->cdr->cdr->car;
+		eval();
 
-			/* Get that new value */
-			R0 = R0->cdr->cdr->car;
-			eval();
+		/* Restore target */
+		R2 = pop_cell();
+		/* update that new variable with that value */
+		R2->cdr = R1;
+		gc_write_barrier(R2);
+		goto eval_done;
+	}
+	else if(SYNTAX_LET == syntax)
+	{
+		/* Protect against (let) statements */
+		require(nil != R0->cdr, "bad let in form (let)\n");
 
-			/* Restore target */
-			R2 = pop_cell();
-			/* update that new variable with that value */
-			R2->cdr = R1;
-			return;
-		}
-		else if(R0->car == s_let)
+		/* Our locals are about to be extended */
+		if((NULL != R4) && !saved)
 		{
-			/* Protect against (let) statements */
-			require(nil != R0->cdr, "bad let in form (let)\n");
-
-			/* Clean up locals after let completes */
-			push_cell(g_env);
+			push_cell(R4);
+			saved = TRUE;
+		}
 
-			/* Protect the s-expression from garbage collection */
-			push_cell(R0->cdr->cdr);
+		/* Clean up locals after let completes */
+		push_cell(g_env);
 
-			/* Deal with the (let ((pieces)) ..) */
-			for(R0 = R0->cdr->car; R0 != nil; R0 = R0->cdr)
-			{
-				push_cell(R0);
-				R0 = R0->car->cdr->car;
-				eval();
-				R0 = pop_cell();
-				if(NULL != R4) R4 = make_cons(make_cons(R0->car->car, R1), R4);
-				else g_env = make_cons(make_cons(R0->car->car, R1), g_env);
-			}
+		/* Protect the s-expression from garbage collection */
+		push_cell(R0->cdr->cdr);
 
-			/* Lets execute the pieces of the of (let ((..)) pieces) */
-			R0 = pop_cell();
-			R0 = make_cons(s_begin, R0);
+		/* Deal with the (let ((pieces)) ..) */
+		for(R0 = R0->cdr->car; R0 != nil; R0 = R0->cdr)
+		{
+			push_cell(R0);
+			R0 = R0->car->cdr->car;
 			eval();
+			R0 = pop_cell();
+			if(NULL != R4) R4 = make_cons(make_cons(R0->car->car, R1), R4);
+			else extend_global_env(R0->car->car, R1);
+		}
+
+		/* Lets execute the pieces of the of (let ((..)) pieces) */
+		R0 = pop_cell();
+		eval_body();
 
-			/* Actual clean up */
+		/* Locals go away with R4 so the last is in tail position */
+		if(NULL != R4)
+		{
 			g_env = pop_cell();
-			return;
+			goto tail_call;
 		}
-		else if(R0->car == s_begin)
-		{
-			/* Protect against (begin) statements */
-			require(nil != R0->cdr, "sequence of zero expressions in form (begin)\n");
 
-			/* Get past the begin to the list of s-expressions */
-			R0 = R0->cdr;
+		eval();
 
-			/* Catch a naked begin */
-			require(CONS == R0->type, "naked begin is not supported\n");
+		/* Actual clean up */
+		g_env = pop_cell();
+		goto eval_done;
+	}
+	else if(SYNTAX_BEGIN == syntax)
+	{
+		/* Get past the begin to the list of s-expressions */
+		R0 = R0->cdr;
+		eval_body();
+		goto tail_call;
+	}
+	else if(SYNTAX_WHILE == syntax)
+	{
+		require(nil != R0->cdr, "while requires a conditional\n");
+		/* Check if we should even run the while */
+		push_cell(R0);
+		R0 = R0->cdr->car;
+		eval();
+		R0 = pop_cell();
 
-			/* Loop through s-expressions and returning the last return value */
-			while(R0 != nil)
+		while(cell_f != R1)
+		{
+			/* Perform single evalutation of the while if it exists */
+			if(nil != R0->cdr->cdr)
 			{
-				/* make sure it is a proper list */
-				require(NULL != R0->cdr, "you managed to pass begin without a nil terminated list\n");
-
-				/* Protect the rest of the list */
-				push_cell(R0->cdr);
-
-				/* Evaluate current leading s-expression */
-				R0 = R0->car;
+				push_cell(R0);
+				R0 = R0->cdr->cdr;
+				eval_body();
 				eval();
-
-				/* Move to next s-expression*/
 				R0 = pop_cell();
 			}
 
-			return;
-		}
-		else if(R0->car == s_while)
-		{
-			require(nil != R0->cdr, "while requires a conditional\n");
-			/* Check if we should even run the while */
+			/* Perform another run of the conditional*/
 			push_cell(R0);
 			R0 = R0->cdr->car;
 			eval();
 			R0 = pop_cell();
+		}
 
-			while(cell_f != R1)
-			{
-				/* Perform single evalutation of the while if it exists */
-				if(nil != R0->cdr->cdr)
-				{
-					push_cell(R0);
-					R0 = make_cons(s_begin, R0->cdr->cdr);
-					eval();
-					R0 = pop_cell();
-				}
-
-				/* Perform another run of the conditional*/
-				push_cell(R0);
-				R0 = R0->cdr->car;
-				eval();
-				R0 = pop_cell();
-			}
+		/* We return the last R1 (until I find out better) */
+		goto eval_done;
+	}
 
-			/* We return the last R1 (until I find out better) */
-			return;
-		}
+application:
+	/* Deal with case of (thing ...), so first figure out what thing is */
+	push_cell(R0->cdr);
+	R0 = R0->car;
+	eval();
+	R0 = pop_cell();
 
-		/* Deal with case of (thing ...), so first figure out what thing is */
-		push_cell(R0->cdr);
-		R0 = R0->car;
-		eval();
-		R0 = pop_cell();
+	/* Primitives of fixed arity need no list of their arguments */
+	if((PRIMOP == R1->type) && (NULL != R1->cdr))
+	{
+		if(eval_fixed(R1)) goto eval_done;
+	}
 
-		/* Now figure out what everything else is so that it can work on it */
-		push_cell(R1);
-		evlis();
+	/* Now figure out what everything else is so that it can work on it */
+	push_cell(R1);
+	evlis();
 
-		/* Now apply thing to that list of values */
-		R0 = pop_cell();
-		apply(R0, R1);
-		return;
+	/* Now apply thing to that list of values */
+	R0 = pop_cell();
+	if((LAMBDA == R0->type) && !saved)
+	{
+		push_cell(R4);
+		saved = TRUE;
 	}
+	if(tail_apply(R0, R1, TRUE)) goto tail_call;
 
-	/* Fall through case */
-	R1 = R0;
+eval_done:
+	if(saved) R4 = pop_cell();
 }
 
 
@@ -759,7 +1221,7 @@ struct cell* builtin_apply(struct cell* args)
 	/* ensure preservation of s-expression during application */
 	R0 = args;
 	struct cell* r;
-	apply(args->car, args->cdr->car);
+	apply(args->car, args->cdr->car, FALSE);
 	r = R1;
 	g_env = pop_cell();
 	R1 = pop_cell();
@@ -27,8 +27,8 @@ struct cell* builtin_append(struct cell* args);
 struct cell* builtin_apply(struct cell* args);
 struct cell* builtin_ash(struct cell* args);
 struct cell* builtin_booleanp(struct cell* args);
-struct cell* builtin_car(struct cell* args);
-struct cell* builtin_cdr(struct cell* args);
+struct cell* builtin_car(struct cell* a);
+struct cell* builtin_cdr(struct cell* a);
 struct cell* builtin_char_alphabetic(struct cell* args);
 struct cell* builtin_char_numeric(struct cell* args);
 struct cell* builtin_char_to_number(struct cell* args);
@@ -37,7 +37,7 @@ struct cell* builtin_chareq(struct cell* args);
 struct cell* builtin_charp(struct cell* args);
 struct cell* builtin_close(struct cell* args);
 struct cell* builtin_command_line(struct cell* args);
-struct cell* builtin_cons(struct cell* args);
+struct cell* builtin_cons(struct cell* a, struct cell* b);
 struct cell* builtin_current_error_port(struct cell* args);
 struct cell* builtin_current_input_port(struct cell* args);
 struct cell* builtin_current_output_port(struct cell* args);
@@ -47,9 +47,13 @@ struct cell* builtin_display_error(struct cell* args);
 struct cell* builtin_div(struct cell* args);
 struct cell* builtin_eofp (struct cell* args);
 struct cell* builtin_eq(struct cell* args);
+struct cell* builtin_eq2(struct cell* a, struct cell* b);
 struct cell* builtin_equal(struct cell* args);
 struct cell* builtin_eqv(struct cell* args);
 struct cell* builtin_freecell(struct cell* args);
+struct cell* builtin_gc_stats(struct cell* args);
+struct cell* builtin_heap_histogram(struct cell* args);
+struct cell* builtin_seal_heap(struct cell* args);
 struct cell* builtin_get_env(struct cell* args);
 struct cell* builtin_halt(struct cell* args);
 struct cell* builtin_intp(struct cell* args);
@@ -70,14 +74,17 @@ struct cell* builtin_make_record_type(struct cell* args);
 struct cell* builtin_make_string(struct cell* args);
 struct cell* builtin_make_vector(struct cell* args);
 struct cell* builtin_mod(struct cell* args);
-struct cell* builtin_not(struct cell* args);
+struct cell* builtin_not(struct cell* a);
 struct cell* builtin_number_to_char(struct cell* args);
 struct cell* builtin_number_to_string(struct cell* args);
 struct cell* builtin_numeq(struct cell* args);
+struct cell* builtin_numeq2(struct cell* a, struct cell* b);
 struct cell* builtin_numge(struct cell* args);
 struct cell* builtin_numgt(struct cell* args);
+struct cell* builtin_numgt2(struct cell* a, struct cell* b);
 struct cell* builtin_numle(struct cell* args);
 struct cell* builtin_numlt(struct cell* args);
+struct cell* builtin_numlt2(struct cell* a, struct cell* b);
 struct cell* builtin_open_read(struct cell* args);
 struct cell* builtin_open_write(struct cell* args);
 struct cell* builtin_or(struct cell* args);
@@ -87,6 +94,7 @@ struct cell* builtin_primitive_load(struct cell* args);
 struct cell* builtin_primitivep(struct cell* args);
 struct cell* builtin_procedurep(struct cell* args);
 struct cell* builtin_prod(struct cell* args);
+struct cell* builtin_prod2(struct cell* a, struct cell* b);
 struct cell* builtin_read_byte(struct cell* args);
 struct cell* builtin_record_accessor(struct cell* args);
 struct cell* builtin_record_constructor(struct cell* args);
@@ -102,8 +110,8 @@ struct cell* builtin_reverse(struct cell* args);
 struct cell* builtin_set_current_error_port(struct cell* args);
 struct cell* builtin_set_current_input_port(struct cell* args);
 struct cell* builtin_set_current_output_port(struct cell* args);
-struct cell* builtin_setcar(struct cell* args);
-struct cell* builtin_setcdr(struct cell* args);
+struct cell* builtin_setcar(struct cell* a, struct cell* b);
+struct cell* builtin_setcdr(struct cell* a, struct cell* b);
 struct cell* builtin_string_append(struct cell* args);
 struct cell* builtin_string_index(struct cell* args);
 struct cell* builtin_string_ref(struct cell* args);
@@ -116,13 +124,15 @@ struct cell* builtin_string_to_symbol(struct cell* args);
 struct cell* builtin_stringeq(struct cell* args);
 struct cell* builtin_stringp(struct cell* args);
 struct cell* builtin_sub(struct cell* args);
+struct cell* builtin_sub2(struct cell* a, struct cell* b);
 struct cell* builtin_substring(struct cell* args);
 struct cell* builtin_sum(struct cell* args);
+struct cell* builtin_sum2(struct cell* a, struct cell* b);
 struct cell* builtin_symbol_to_string(struct cell* args);
 struct cell* builtin_ttyname(struct cell* args);
 struct cell* builtin_vector_length(struct cell* args);
-struct cell* builtin_vector_ref(struct cell* args);
-struct cell* builtin_vector_set(struct cell* args);
+struct cell* builtin_vector_ref(struct cell* v, struct cell* i);
+struct cell* builtin_vector_set(struct cell* v, struct cell* i, struct cell* x);
 struct cell* builtin_vector_to_list(struct cell* args);
 struct cell* builtin_vectoreq(struct cell* args);
 struct cell* builtin_vectorp(struct cell* args);
@@ -130,19 +140,36 @@ struct cell* builtin_write(struct cell* args);
 struct cell* builtin_write_error(struct cell* args);
 struct cell* builtin_xor(struct cell* args);
 struct cell* equal(struct cell* a, struct cell* b);
+struct cell* make_fixed_prim(void* fun, void* fixed, int arity);
+struct cell* make_int(int a);
 struct cell* make_prim(void* fun);
 struct cell* make_string(char* a, int length);
 struct cell* make_sym(char* name);
-struct cell* nullp(struct cell* args);
-struct cell* pairp(struct cell* args);
+void add_symbol(struct cell* sym);
+void extend_global_env(struct cell* sym, struct cell* value);
+struct cell* nullp(struct cell* a);
+struct cell* pairp(struct cell* a);
 struct cell* portp(struct cell* args);
 struct cell* symbolp(struct cell* args);
 
 
+/****************************************
+ * A special form is a SYM with the INT *
+ * of its syntax id in CDR, so eval can *
+ * tell one from any other SYM with a   *
+ * single load.                         *
+ ****************************************/
+struct cell* make_syntax(char* name, int id)
+{
+	struct cell* sym = make_sym(name);
+	sym->cdr = make_int(id);
+	return sym;
+}
+
 void spinup(struct cell* sym, struct cell* prim)
 {
-	all_symbols = make_cons(sym, all_symbols);
-	g_env = make_cons(make_cons(sym, prim), g_env);
+	add_symbol(sym);
+	extend_global_env(sym, prim);
 }
 
 /*** Initialization ***/
@@ -153,29 +180,29 @@ void init_sl3()
 	cell_t = make_sym("#t");
 	cell_f = make_sym("#f");
 	cell_dot = make_sym(".");
-	quote = make_sym("quote");
-	quasiquote = make_sym("quasiquote");
+	quote = make_syntax("quote", SYNTAX_QUOTE);
+	quasiquote = make_syntax("quasiquote", SYNTAX_QUASIQUOTE);
 	unquote = make_sym("unquote");
 	unquote_splicing = make_sym("unquote-splicing");
 	cell_unspecified = make_sym("*unspecified*");
-	s_if = make_sym("if");
-	s_when = make_sym("when");
-	s_case = make_sym("case");
+	s_if = make_syntax("if", SYNTAX_IF);
+	s_when = make_syntax("when", SYNTAX_WHEN);
+	s_case = make_syntax("case", SYNTAX_CASE);
 	s_else = make_sym("else");
-	s_cond = make_sym("cond");
-	s_lambda = make_sym("lambda");
-	s_macro = make_sym("macro");
-	s_and = make_sym("and");
-	s_or = make_sym("or");
-	s_define = make_sym("define");
+	s_cond = make_syntax("cond", SYNTAX_COND);
+	s_lambda = make_syntax("lambda", SYNTAX_LAMBDA);
+	s_macro = make_syntax("macro", SYNTAX_MACRO);
+	s_and = make_syntax("and", SYNTAX_AND);
+	s_or = make_syntax("or", SYNTAX_OR);
+	s_define = make_syntax("define", SYNTAX_DEFINE);
 	s_define_macro = make_sym("define-macro");
-	s_setb = make_sym("set!");
-	s_begin = make_sym("begin");
-	s_let = make_sym("let");
-	s_while = make_sym("while");
+	s_setb = make_syntax("set!", SYNTAX_SETB);
+	s_begin = make_syntax("begin", SYNTAX_BEGIN);
+	s_let = make_syntax("let", SYNTAX_LET);
+	s_while = make_syntax("while", SYNTAX_WHILE);
 
 	/* Globals of interest */
-	all_symbols = make_cons(nil, nil);
+	all_symbols = nil;
 	g_env = nil;
 
 	/* Add Eval Specials */
@@ -211,8 +238,8 @@ void init_sl3()
 	spinup(make_sym("list?"), make_prim(builtin_listp));
 	spinup(make_sym("number?"), make_prim(builtin_intp));
 	spinup(make_sym("boolean?"), make_prim(builtin_booleanp));
-	spinup(make_sym("null?"), make_prim(nullp));
-	spinup(make_sym("pair?"), make_prim(pairp));
+	spinup(make_sym("null?"), make_fixed_prim(NULL, nullp, 1));
+	spinup(make_sym("pair?"), make_fixed_prim(NULL, pairp, 1));
 	spinup(make_sym("port?"), make_prim(portp));
 	spinup(make_sym("primitive?"), make_prim(builtin_primitivep));
 	spinup(make_sym("procedure?"), make_prim(builtin_procedurep));
@@ -222,21 +249,21 @@ void init_sl3()
 	spinup(make_sym("defined?"), make_prim(builtin_definedp));
 
 	/* Comparisions */
-	spinup(make_sym("<"), make_prim(builtin_numlt));
+	spinup(make_sym("<"), make_fixed_prim(builtin_numlt, builtin_numlt2, 2));
 	spinup(make_sym("<="), make_prim(builtin_numle));
-	spinup(make_sym("="), make_prim(builtin_numeq));
-	spinup(make_sym(">"), make_prim(builtin_numgt));
+	spinup(make_sym("="), make_fixed_prim(builtin_numeq, builtin_numeq2, 2));
+	spinup(make_sym(">"), make_fixed_prim(builtin_numgt, builtin_numgt2, 2));
 	spinup(make_sym(">="), make_prim(builtin_numge));
 	spinup(make_sym("char=?"), make_prim(builtin_chareq));
 	spinup(make_sym("string=?"), make_prim(builtin_stringeq));
-	spinup(make_sym("eq?"), make_prim(builtin_eq));
+	spinup(make_sym("eq?"), make_fixed_prim(builtin_eq, builtin_eq2, 2));
 	spinup(make_sym("eqv?"), make_prim(builtin_eqv));
 	spinup(make_sym("equal?"), make_prim(builtin_equal));
 
 	/* Math */
-	spinup(make_sym("*"), make_prim(builtin_prod));
-	spinup(make_sym("+"), make_prim(builtin_sum));
-	spinup(make_sym("-"), make_prim(builtin_sub));
+	spinup(make_sym("*"), make_fixed_prim(builtin_prod, builtin_prod2, 2));
+	spinup(make_sym("+"), make_fixed_prim(builtin_sum, builtin_sum2, 2));
+	spinup(make_sym("-"), make_fixed_prim(builtin_sub, builtin_sub2, 2));
 	spinup(make_sym("ash"), make_prim(builtin_ash));
 	spinup(make_sym("logand"), make_prim(builtin_logand));
 	spinup(make_sym("logior"), make_prim(builtin_logor));
@@ -283,8 +310,8 @@ void init_sl3()
 	/* Deal with Vectors */
 	spinup(make_sym("make-vector"), make_prim(builtin_make_vector));
 	spinup(make_sym("vector-length"), make_prim(builtin_vector_length));
-	spinup(make_sym("vector-set!"), make_prim(builtin_vector_set));
-	spinup(make_sym("vector-ref"), make_prim(builtin_vector_ref));
+	spinup(make_sym("vector-set!"), make_fixed_prim(NULL, builtin_vector_set, 3));
+	spinup(make_sym("vector-ref"), make_fixed_prim(NULL, builtin_vector_ref, 2));
 	spinup(make_sym("vector->list"), make_prim(builtin_vector_to_list));
 
 	/* Deal with Strings */
@@ -318,25 +345,28 @@ void init_sl3()
 	spinup(make_sym("char-numeric?"), make_prim(builtin_char_numeric));
 
 	/* Deal with logicals */
-	spinup(make_sym("not"), make_prim(builtin_not));
+	spinup(make_sym("not"), make_fixed_prim(NULL, builtin_not, 1));
 
 	/* Deal with environment */
 	spinup(make_sym("getenv"), make_prim(builtin_get_env));
 	spinup(make_sym("command-line"), make_prim(builtin_command_line));
 
 	/* Lisp classics */
-	spinup(make_sym("cons"), make_prim(builtin_cons));
-	spinup(make_sym("car"), make_prim(builtin_car));
-	spinup(make_sym("cdr"), make_prim(builtin_cdr));
+	spinup(make_sym("cons"), make_fixed_prim(NULL, builtin_cons, 2));
+	spinup(make_sym("car"), make_fixed_prim(NULL, builtin_car, 1));
+	spinup(make_sym("cdr"), make_fixed_prim(NULL, builtin_cdr, 1));
 	spinup(make_sym("reverse"), make_prim(builtin_reverse));
-	spinup(make_sym("set-car!"), make_prim(builtin_setcar));
-	spinup(make_sym("set-cdr!"), make_prim(builtin_setcdr));
+	spinup(make_sym("set-car!"), make_fixed_prim(NULL, builtin_setcar, 2));
+	spinup(make_sym("set-cdr!"), make_fixed_prim(NULL, builtin_setcdr, 2));
 	spinup(make_sym("apply"), make_prim(builtin_apply));
 	spinup(make_sym("primitive-eval"), make_prim(builtin_primitive_eval));
 	spinup(make_sym("exit"), make_prim(builtin_halt));
 
 	/* MES unique */
 	spinup(make_sym("core:free_mem"), make_prim(builtin_freecell));
+	spinup(make_sym("core:gc-stats"), make_prim(builtin_gc_stats));
+	spinup(make_sym("core:heap-histogram"), make_prim(builtin_heap_histogram));
+	spinup(make_sym("core:seal-heap"), make_prim(builtin_seal_heap));
 	spinup(make_sym("%version"), make_string("0.19", 4));
 	spinup(make_sym("vector=?"), make_prim(builtin_vectoreq));
 	spinup(make_sym("list=?"), make_prim(builtin_listeq));
@@ -21,8 +21,8 @@
 
 #include "mes.h"
 /* Imported functions */
+struct cell* intern(char* name);
 struct cell* make_keyword(char* name);
-struct cell* make_sym(char* name);
 
 struct cell* builtin_keywordp(struct cell* args)
 {
@@ -38,8 +38,7 @@ struct cell* builtin_keyword_to_symbol(struct cell* args)
 	require(nil != args, "keyword->symbol requires arguments\n");
 	require(nil == args->cdr, "keyword->symbol recieved too many arguments\n");
 	require(KEYWORD == args->car->type, "keyword->symbol did not recieve a keyword\n");
-
-	return make_sym(args->car->string + 2);
+	return intern(args->car->string + 2);
 }
 
 struct cell* builtin_string_to_keyword(struct cell* args)
@@ -22,11 +22,14 @@
 #include "mes.h"
 
 /* Imported functions */
+char* pop_string(unsigned size);
 struct cell* equal(struct cell* a, struct cell* b);
+struct cell* findsym(char *name);
 struct cell* make_char(int a);
 struct cell* make_int(int a);
 struct cell* make_string(char* a, int length);
 struct cell* make_sym(char* name);
+void add_symbol(struct cell* sym);
 
 struct cell* string_to_list(char* string, int length)
 {
@@ -54,7 +57,7 @@ int list_length(struct cell* args)
 struct cell* list_to_string(struct cell* args)
 {
 	require(CONS == args->type, "mes_list.c: list_to_string recieved wrong type\n");
-	char* string = calloc(list_length(args) + 1, sizeof(char));
+	char* string = pop_string(list_length(args) + 1);
 	int index = 0;
 	struct cell* i;
 	for(i = args->car; nil != i; i = i->cdr)
@@ -135,6 +138,7 @@ struct cell* builtin_append(struct cell* args)
 		require(((nil == i->cdr->car) || (CONS == i->cdr->car->type)), "append requires a list argument\n");
 		i->car = append(i->car, i->cdr->car);
 		i->cdr = i->cdr->cdr;
+		gc_write_barrier(i);
 	}
 	return i->car;
 }
@@ -197,7 +201,13 @@ struct cell* builtin_list_to_symbol(struct cell* args)
 	require(nil != args, "list->symbol requires an argument\n");
 	require(nil == args->cdr, "list->symbol only allows a single argument\n");
 	struct cell* r = list_to_string(args);
+	struct cell* sym = findsym(r->string);
+	if(nil != sym) return sym->car;
+
+	/* ENV held the length */
 	r->type = SYM;
+	r->env = NULL;
+	add_symbol(r);
 	return r;
 }
 
@@ -29,12 +29,19 @@ struct cell* pop_cell();
 struct cell* reverse_list(struct cell* head);
 void push_cell(struct cell* a);
 struct cell* cell_invoke_function(struct cell* cell, struct cell* vals);
-void apply(struct cell* proc, struct cell* vals);
+void apply(struct cell* proc, struct cell* vals, int owned);
+void forget_globals();
+void extend_global_env(struct cell* sym, struct cell* value);
+struct cell* global_binding(struct cell* key);
 
 struct cell* macro_extend_env(struct cell* sym, struct cell* val, struct cell* env)
 {
+	forget_globals();
 	env->cdr = make_cons(env->car, env->cdr);
+	/* Before allocating again, as that may collect */
+	gc_write_barrier(env);
 	env->car = make_cons(sym, val);
+	gc_write_barrier(env);
 	return nil;
 }
 
@@ -47,6 +54,7 @@ struct cell* define_macro(struct cell* exp, struct cell* env)
 		struct cell* arguments = exp->cdr->car->cdr;
 		struct cell* name = exp->cdr->car->car;
 		exp->cdr = make_cons(name, make_cons(make_cons(s_macro, make_cons(arguments, fun)), nil));
+		gc_write_barrier(exp);
 	}
 
 	return(macro_extend_env(exp->cdr->car, exp->cdr->cdr->car, env));
@@ -150,7 +158,9 @@ struct cell* macro_list(struct cell* exps, struct cell* env)
 	if(exps == nil) return nil;
 
 	struct cell* i = macro_eval(exps->car, env);
+	push_cell(i);
 	struct cell* j = macro_list(exps->cdr, env);
+	i = pop_cell();
 	return make_cons(i, j);
 }
 
@@ -231,7 +241,7 @@ struct cell* expand_let(struct cell* exp, struct cell* env)
 		macro_eval(R0, R1);
 		R0 = pop_cell();
 		if(NULL != R4) R4 = make_cons(make_cons(R0->car->car, R1), R4);
-		else g_env = make_cons(make_cons(R0->car->car, R1), g_env);
+		else extend_global_env(R0->car->car, R1);
 	}
 
 	/* Lets execute the pieces of the of (let ((..)) pieces) */
@@ -268,6 +278,7 @@ struct cell* expand_define(struct cell* exp, struct cell* env)
 		R4 = R0->cdr->car->car;
 		/* by converting it into (define foo (lambda (a b .. N) (s-expression))) form */
 		R0->cdr = make_cons(R4, make_cons(make_cons(s_lambda, make_cons(R3, R2)), nil));
+		gc_write_barrier(R0);
 		R4 = pop_cell();
 		R3 = pop_cell();
 		R2 = pop_cell();
@@ -292,10 +303,11 @@ struct cell* expand_define(struct cell* exp, struct cell* env)
 	if((LAMBDA == R1->type) || (MACRO == R1->type))
 	{
 		R1->env = make_cons(make_cons(R0, R1), R1->env);
+		gc_write_barrier(R1);
 	}
 
 	/* We now need to extend the environment with our new name */
-	g_env = make_cons(make_cons(R0, R1), g_env);
+	extend_global_env(R0, R1);
 	R1 = cell_unspecified;
 	exp = R0;
 	R1 = pop_cell();
@@ -305,26 +317,47 @@ struct cell* expand_define(struct cell* exp, struct cell* env)
 
 struct cell* expand_cons(struct cell* exp, struct cell* env)
 {
-	if(exp->car == s_if) return expand_if(exp, env);
-	if(exp->car == s_cond) return expand_cond(exp->cdr, env);
-	if(exp->car == s_lambda) return make_proc(exp->cdr->car, exp->cdr->cdr, env);
-	if(exp->car == quote) return exp->cdr->car;
-	if(exp->car == s_macro) return make_macro(exp->cdr->car, exp->cdr->cdr, env);
-	if(exp->car == s_define) return expand_define(exp, env);
-	if(exp->car == s_let) return expand_let(exp, env);
-	if(exp->car == quasiquote) return expand_quasiquote(exp->cdr->car, env);
-
-	R0 = macro_eval(exp->car, env);
-	push_cell(R0);
-	R1 = macro_list(exp->cdr, env);
-	R0 = pop_cell();
-	return macro_apply(R0, R1);
+	/* Protect the s-expression and environment from garbage collection */
+	push_cell(exp);
+	push_cell(env);
+
+	struct cell* r;
+	int syntax = 0;
+	if((SYM == exp->car->type) && (NULL != exp->car->cdr)) syntax = exp->car->cdr->value;
+
+	if(SYNTAX_IF == syntax) r = expand_if(exp, env);
+	else if(SYNTAX_COND == syntax) r = expand_cond(exp->cdr, env);
+	else if(SYNTAX_LAMBDA == syntax) r = make_proc(exp->cdr->car, exp->cdr->cdr, env);
+	else if(SYNTAX_QUOTE == syntax) r = exp->cdr->car;
+	else if(SYNTAX_MACRO == syntax) r = make_macro(exp->cdr->car, exp->cdr->cdr, env);
+	else if(SYNTAX_DEFINE == syntax) r = expand_define(exp, env);
+	else if(SYNTAX_LET == syntax) r = expand_let(exp, env);
+	else if(SYNTAX_QUASIQUOTE == syntax) r = expand_quasiquote(exp->cdr->car, env);
+	else
+	{
+		R0 = macro_eval(exp->car, env);
+		push_cell(R0);
+		R1 = macro_list(exp->cdr, env);
+		R0 = pop_cell();
+		r = macro_apply(R0, R1);
+	}
+
+	pop_cell();
+	pop_cell();
+	return r;
 }
 
 struct cell* macro_assoc(struct cell* key, struct cell* alist)
 {
 	if(nil == alist) return nil;
+	if(SYM != key->type) return nil;
 	struct cell* i;
+	if(alist == g_env)
+	{
+		i = global_binding(key);
+		if(NULL != i) return i;
+	}
+
 	for(i = alist; nil != i; i = i->cdr)
 	{
 		if(i->car->car->string == key->string) return i->car;
@@ -352,9 +385,11 @@ struct cell* macro_progn(struct cell* exps, struct cell* env)
 	R0 = exps;
 macro_progn_reset:
 	if(R0 == nil) return R1;
+	push_cell(env);
 	push_cell(R0->cdr);
 	R1 = macro_eval(R0->car, env);
 	R0 = pop_cell();
+	env = pop_cell();
 	goto macro_progn_reset;
 }
 
@@ -366,16 +401,27 @@ struct cell* macro_extend(struct cell* env, struct cell* syms, struct cell* vals
 		return env;
 	}
 
+	/* Protect the environment so far from garbage collection */
+	push_cell(env);
+	struct cell* binding;
 	if(cell_dot == syms->car)
 	{
-		return make_cons(make_cons(syms->cdr->car, vals), env);
+		binding = make_cons(syms->cdr->car, vals);
+		env = pop_cell();
+		return make_cons(binding, env);
 	}
 
-	return macro_extend(make_cons(make_cons(syms->car, vals->car), env), syms->cdr, vals->cdr);
+	binding = make_cons(syms->car, vals->car);
+	env = pop_cell();
+	return macro_extend(make_cons(binding, env), syms->cdr, vals->cdr);
 }
 
 struct cell* macro_apply(struct cell* proc, struct cell* vals)
 {
+	/* Protect the procedure and its arguments from garbage collection */
+	push_cell(proc);
+	push_cell(vals);
+
 	struct cell* temp;
 	if(proc->type == PRIMOP)
 	{
@@ -385,7 +431,7 @@ struct cell* macro_apply(struct cell* proc, struct cell* vals)
 	{
 		push_cell(R0);
 		push_cell(R1);
-		apply(proc, vals);
+		apply(proc, vals, FALSE);
 		temp = R1;
 		R1 = pop_cell();
 		R0 = pop_cell();
@@ -399,6 +445,9 @@ struct cell* macro_apply(struct cell* proc, struct cell* vals)
 	{
 		temp = macro_eval(proc, g_env);
 	}
+
+	pop_cell();
+	pop_cell();
 	return temp;
 }
 
@@ -419,6 +468,7 @@ struct cell* expand_macros(struct cell* exp)
 	hold = expand_macros(R0->car);
 	R0 = pop_cell(R0);
 	R0->car = hold;
+	gc_write_barrier(R0);
 
 	hold = macro_assoc(R0->car, g_env);
 	if(CONS == hold->type)
@@ -434,5 +484,6 @@ struct cell* expand_macros(struct cell* exp)
 	hold = expand_macros(R0->cdr);
 	R0 = pop_cell(R0);
 	R0->cdr = hold;
+	gc_write_barrier(R0);
 	return R0;
 }
@@ -0,0 +1,289 @@
+/* -*-comment-start: "//";comment-end:""-*-
+ * GNU Mes --- Maxwell Equations of Software
+ * Copyright © 2016,2017,2018 Jan (janneke) Nieuwenhuizen <janneke@gnu.org>
+ * Copyright © 2019 Jeremiah Orians
+ *
+ * This file is part of GNU Mes.
+ *
+ * GNU Mes is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * GNU Mes is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mes.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <time.h>
+
+/* Imported functions */
+int car_is_cell(int type);
+int env_is_cell(int type);
+
+/* Imported from mes_cell.c */
+extern char* gc_mark_bits;
+extern struct cell* gc_block_start;
+
+/****************************************
+ * The parts of memory management that  *
+ * need more than M2-Planet provides;   *
+ * mes_platform_m2.c has the versions   *
+ * used when built with M2-Planet.      *
+ ****************************************/
+
+/****************************************
+ * Reserve SIZE bytes of address space  *
+ * without using any memory yet.        *
+ ****************************************/
+void* reserve_memory(size_t size)
+{
+	void* r = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if(MAP_FAILED == r) return NULL;
+	return r;
+}
+
+/****************************************
+ * Make SIZE bytes at OFFSET into the   *
+ * reserved memory usable.              *
+ ****************************************/
+int commit_memory(void* base, size_t offset, size_t size)
+{
+	return (0 == mprotect((char*)base + offset, size, PROT_READ | PROT_WRITE));
+}
+
+/****************************************
+ * A monotonic clock for timing garbage *
+ * collections.                         *
+ ****************************************/
+SCM clock_microseconds()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (t.tv_sec * 1000000) + (t.tv_nsec / 1000);
+}
+
+
+/****************************************
+ * The parallel marker. Every worker    *
+ * walks the cells on its own stack,    *
+ * claiming them by atomically setting  *
+ * their bit in gc_mark_bits; so a cell *
+ * reachable from more than one place   *
+ * is still only walked once. Whenever  *
+ * a worker is idle, the others give    *
+ * half of their stacks to the shared   *
+ * stack for it to take from. Once all  *
+ * of them are idle with nothing shared *
+ * the mark is done.                    *
+ ****************************************/
+struct mark_worker
+{
+	struct cell** stack;
+	unsigned size;
+	unsigned pointer;
+	int marked;
+	pthread_t thread;
+};
+
+pthread_mutex_t mark_lock;
+pthread_cond_t mark_wake;
+struct cell** mark_shared;
+unsigned mark_shared_size;
+unsigned mark_shared_count;
+unsigned mark_threads;
+unsigned mark_idle;
+int mark_done;
+
+
+/****************************************
+ * Set the bit of C, returning FALSE if *
+ * some worker already had.             *
+ ****************************************/
+int claim_cell(struct cell* c)
+{
+	unsigned n = c - gc_block_start;
+	char bit = 1 << (n & 7);
+	if(0 != (__atomic_load_n(gc_mark_bits + (n >> 3), __ATOMIC_RELAXED) & bit)) return FALSE;
+	return (0 == (__atomic_fetch_or(gc_mark_bits + (n >> 3), bit, __ATOMIC_RELAXED) & bit));
+}
+
+
+void worker_push(struct mark_worker* w, struct cell* c)
+{
+	if(w->pointer == w->size)
+	{
+		w->size = w->size * 2;
+		w->stack = realloc(w->stack, w->size * sizeof(struct cell*));
+		require(NULL != w->stack, "unable to grow a mark stack\n");
+	}
+	w->stack[w->pointer] = c;
+	w->pointer = w->pointer + 1;
+}
+
+
+/****************************************
+ * Hand the bottom half of our stack,   *
+ * which is the oldest and thus most    *
+ * likely to lead to a lot of cells, to *
+ * whoever is idle.                     *
+ ****************************************/
+void share_work(struct mark_worker* w)
+{
+	if(2 > w->pointer) return;
+	if(0 == __atomic_load_n(&mark_idle, __ATOMIC_RELAXED)) return;
+
+	unsigned half = w->pointer / 2;
+	unsigned i;
+	pthread_mutex_lock(&mark_lock);
+	if(mark_shared_count + half > mark_shared_size)
+	{
+		mark_shared_size = (mark_shared_count + half) * 2;
+		mark_shared = realloc(mark_shared, mark_shared_size * sizeof(struct cell*));
+		require(NULL != mark_shared, "unable to grow the shared mark stack\n");
+	}
+	for(i = 0; i < half; i = i + 1) mark_shared[mark_shared_count + i] = w->stack[i];
+	mark_shared_count = mark_shared_count + half;
+	pthread_cond_broadcast(&mark_wake);
+	pthread_mutex_unlock(&mark_lock);
+
+	for(i = half; i < w->pointer; i = i + 1) w->stack[i - half] = w->stack[i];
+	w->pointer = w->pointer - half;
+}
+
+
+/****************************************
+ * Wait for work to be shared with us,  *
+ * returning FALSE once the mark is     *
+ * done.                                *
+ ****************************************/
+int take_work(struct mark_worker* w)
+{
+	pthread_mutex_lock(&mark_lock);
+	__atomic_store_n(&mark_idle, mark_idle + 1, __ATOMIC_RELAXED);
+	while((0 == mark_shared_count) && !mark_done)
+	{
+		if(mark_idle == mark_threads)
+		{
+			mark_done = TRUE;
+			pthread_cond_broadcast(&mark_wake);
+		}
+		else pthread_cond_wait(&mark_wake, &mark_lock);
+	}
+
+	if(mark_done)
+	{
+		pthread_mutex_unlock(&mark_lock);
+		return FALSE;
+	}
+
+	__atomic_store_n(&mark_idle, mark_idle - 1, __ATOMIC_RELAXED);
+	unsigned take = mark_shared_count / mark_threads;
+	if(0 == take) take = 1;
+	while(0 < take)
+	{
+		mark_shared_count = mark_shared_count - 1;
+		worker_push(w, mark_shared[mark_shared_count]);
+		take = take - 1;
+	}
+	pthread_mutex_unlock(&mark_lock);
+	return TRUE;
+}
+
+
+/****************************************
+ * The same walk as unmark_cells does,  *
+ * CDRs iteratively and CARs and ENVs   *
+ * on the stack.                        *
+ ****************************************/
+void* mark_worker_run(void* arg)
+{
+	struct mark_worker* w = arg;
+	struct cell* i;
+
+	do
+	{
+		while(0 < w->pointer)
+		{
+			w->pointer = w->pointer - 1;
+			i = w->stack[w->pointer];
+			for(; NULL != i; i = i->cdr)
+			{
+				if(!claim_cell(i)) break;
+				w->marked = w->marked + 1;
+				if(car_is_cell(i->type) && (NULL != i->car)) worker_push(w, i->car);
+				if(env_is_cell(i->type) && (NULL != i->env)) worker_push(w, i->env);
+				share_work(w);
+			}
+		}
+	} while(take_work(w));
+
+	return NULL;
+}
+
+
+/****************************************
+ * Mark everything reachable from the   *
+ * COUNT ROOTS with up to THREADS       *
+ * threads, returning how many cells    *
+ * were marked or -1 if we could not.   *
+ ****************************************/
+int mark_in_parallel(struct cell** roots, unsigned count, unsigned threads)
+{
+	struct mark_worker* workers = calloc(threads, sizeof(struct mark_worker));
+	if(NULL == workers) return -1;
+
+	unsigned i;
+	for(i = 0; i < threads; i = i + 1)
+	{
+		workers[i].size = 1024;
+		workers[i].stack = malloc(workers[i].size * sizeof(struct cell*));
+		require(NULL != workers[i].stack, "unable to allocate a mark stack\n");
+	}
+
+	/* The roots are shared out like any other work */
+	pthread_mutex_init(&mark_lock, NULL);
+	pthread_cond_init(&mark_wake, NULL);
+	mark_shared_size = count + 1024;
+	mark_shared = malloc(mark_shared_size * sizeof(struct cell*));
+	require(NULL != mark_shared, "unable to allocate the shared mark stack\n");
+	for(i = 0; i < count; i = i + 1) mark_shared[i] = roots[i];
+	mark_shared_count = count;
+	mark_threads = threads;
+	mark_idle = 0;
+	mark_done = FALSE;
+
+	/* We are worker 0 ourselves */
+	unsigned started = 1;
+	while(started < threads)
+	{
+		if(0 != pthread_create(&workers[started].thread, NULL, mark_worker_run, workers + started)) break;
+		started = started + 1;
+	}
+
+	/* Should we not get all the threads we asked for, make do with what we have */
+	pthread_mutex_lock(&mark_lock);
+	mark_threads = started;
+	pthread_mutex_unlock(&mark_lock);
+	mark_worker_run(workers);
+
+	int marked = 0;
+	for(i = 0; i < started; i = i + 1)
+	{
+		if(0 != i) pthread_join(workers[i].thread, NULL);
+		marked = marked + workers[i].marked;
+		free(workers[i].stack);
+	}
+	free(workers);
+	free(mark_shared);
+	pthread_cond_destroy(&mark_wake);
+	pthread_mutex_destroy(&mark_lock);
+	return marked;
+}
@@ -0,0 +1,54 @@
+/* -*-comment-start: "//";comment-end:""-*-
+ * GNU Mes --- Maxwell Equations of Software
+ * Copyright © 2016,2017,2018 Jan (janneke) Nieuwenhuizen <janneke@gnu.org>
+ * Copyright © 2019 Jeremiah Orians
+ *
+ * This file is part of GNU Mes.
+ *
+ * GNU Mes is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * GNU Mes is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mes.h"
+
+/****************************************
+ * M2-Planet has no mmap, so we simply  *
+ * malloc everything up front and       *
+ * committing memory is a no-op.        *
+ * Nor is there a clock, so collections *
+ * all take no time.                    *
+ ****************************************/
+
+void* reserve_memory(size_t size)
+{
+	return malloc(size);
+}
+
+int commit_memory(void* base, size_t offset, size_t size)
+{
+	return TRUE;
+}
+
+SCM clock_microseconds()
+{
+	return 0;
+}
+
+/****************************************
+ * Nor are there threads, so marking is *
+ * always left to unmark_cells.         *
+ ****************************************/
+int mark_in_parallel(struct cell** roots, unsigned count, unsigned threads)
+{
+	return -1;
+}
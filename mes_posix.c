@@ -22,6 +22,7 @@
 #include "mes.h"
 
 /* Imported functions */
+char* pop_string(unsigned size);
 int string_size(char* a);
 struct cell* make_file(FILE* a, char* name);
 struct cell* make_string(char* a, int length);
@@ -30,8 +31,8 @@ struct cell* prim_write(struct cell* args, struct cell* out);
 
 char* ntoab(SCM x, int base, int signed_p)
 {
-	char* p = calloc(13, sizeof(char));
-	p = p + 11;
+	char* r = pop_string(13);
+	char* p = r + 11;
 	p[1] = 0;
 	int sign_p = 0;
 	SCM u = x;
@@ -64,7 +65,15 @@ char* ntoab(SCM x, int base, int signed_p)
 		p = p - 1;
 	}
 
-	return p + 1;
+	/* Strings may only point to the start of what pop_string gave us */
+	int j = 0;
+	do
+	{
+		p = p + 1;
+		r[j] = p[0];
+		j = j + 1;
+	} while(0 != p[0]);
+	return r;
 }
 
 struct cell* builtin_display(struct cell* args)
@@ -68,6 +68,7 @@ struct cell* record_set(struct cell* type, char* name, struct cell* record, stru
 		i = i - 1;
 	}
 	e->car = value;
+	gc_write_barrier(e);
 	return value;
 }
 
@@ -23,11 +23,11 @@
 
 /* Imported functions */
 char* ntoab(SCM x, int base, int signed_p);
-struct cell* findsym(char *name);
+char* pop_string(unsigned size);
+struct cell* intern(char* name);
 struct cell* make_char(int a);
 struct cell* make_int(int a);
 struct cell* make_string(char* a, int length);
-struct cell* make_sym(char* name);
 
 int string_size(char* a)
 {
@@ -91,7 +91,8 @@ char* string_append(char* a, char* b)
 
 char* substring(char* s, int start, int end)
 {
-	char* r = calloc((end - start) + 1, sizeof(char));
+	/* Copies END too, so leave room for the terminating NULL */
+	char* r = pop_string((end - start) + 2);
 	int i = 0;
 	while(start <= end)
 	{
@@ -238,11 +239,7 @@ struct cell* builtin_string_to_symbol(struct cell* args)
 	require(nil != args, "string->symbol requires an argument\n");
 	require(nil == args->cdr, "string->symbol only supports a single argument\n");
 	require(STRING == args->car->type, "string->symbol requires a string\n");
-	struct cell* r = findsym(args->car->string);
-	if(nil != r) return r->car;
-	struct cell* newsym =  make_sym(args->car->string);
-	all_symbols = make_cons(newsym, all_symbols);
-	return newsym;
+	return intern(args->car->string);
 }
 
 struct cell* builtin_symbol_to_string(struct cell* args)
@@ -296,7 +293,7 @@ struct cell* builtin_make_string(struct cell* args)
 {
 	require(nil != args, "make-string requires arguments\n");
 	require(INT == args->car->type, "make-string requires an integer to express the number of bytes the string needs to be\n");
-	char* s = calloc(args->car->value + 1, sizeof(char));
+	char* s = pop_string(args->car->value + 1);
 	struct cell* r = make_string(s, args->car->value);
 
 	if(nil != args->cdr)
@@ -346,7 +343,7 @@ struct cell* builtin_string_append(struct cell* args)
 		n = n->cdr;
 	}
 
-	char* d = calloc(size + 1, sizeof(char));
+	char* d = pop_string(size + 1);
 	int i = 0;
 	int j;
 	n = args;
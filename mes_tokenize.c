@@ -21,18 +21,22 @@
 
 #include "mes.h"
 
-struct cell* token_stack;
 
 /* Imported functions */
 char* copy_string(char* target, char* source,int length);
+char* pop_string(unsigned size);
 int escape_lookup(char* c);
 int in_set(int c, char* s);
 int string_size(char* a);
 struct cell* findsym(char *name);
+void add_symbol(struct cell* sym);
 struct cell* make_char(int a);
+struct cell* make_cons(struct cell* a, struct cell* b);
 struct cell* make_keyword(char* name);
 struct cell* make_string(char* a, int length);
 struct cell* make_sym(char* name);
+struct cell* pop_cell();
+void push_cell(struct cell* a);
 void reset_block(char* a);
 
 
@@ -114,11 +118,14 @@ struct cell* tokenize(struct cell* head, char* fullstring, unsigned size)
 
 	if(out_index > 1)
 	{
-		char* store = calloc(string_index + 1, sizeof(char));
+		char* store = pop_string(string_index + 1);
 		copy_string(store, memory_block, out_index);
 		struct cell* temp = make_sym(store);
 		temp->cdr = head;
 		head = temp;
+
+		/* Keep the tokens so far safe while we allocate */
+		token_stack = head;
 	}
 
 	head = tokenize(head, (fullstring+string_index), (size - string_index));
@@ -152,6 +159,7 @@ char special_lookup(char* s)
 
 struct cell* readlist();
 struct cell* readobj();
+struct cell* read_quoted(struct cell* quote_sym);
 struct cell* list_to_vector(struct cell* args);
 struct cell* reader_read_hash(struct cell* a)
 {
@@ -214,31 +222,35 @@ struct cell* atom(struct cell* a)
 	/* Check for quote */
 	if(match("'", a->string))
 	{
-		return make_cons(quote, make_cons(readobj(), nil));
+		return read_quoted(quote);
 	}
 
 	/* Check for quasiquote */
 	if(match("`", a->string))
 	{
-		return make_cons(quasiquote, make_cons(readobj(), nil));
+		return read_quoted(quasiquote);
 	}
 
 	/* Check for unquote */
 	if(match(",", a->string))
 	{
-		return make_cons(unquote, make_cons(readobj(), nil));
+		return read_quoted(unquote);
 	}
 
 	/* Check for unquote-splicing */
 	if(match(",@", a->string))
 	{
-		return make_cons(unquote_splicing, make_cons(readobj(), nil));
+		return read_quoted(unquote_splicing);
 	}
 
 	/* Check for strings */
 	if('\"' == a->string[0])
 	{
-		return make_string(a->string + 1, string_size(a->string + 1));
+		/* Strings may only point to the start of what pop_string gave us */
+		int size = string_size(a->string + 1);
+		char* s = pop_string(size + 1);
+		copy_string(s, a->string + 1, size);
+		return make_string(s, size);
 	}
 
 	/* Check for specials*/
@@ -263,10 +275,22 @@ struct cell* atom(struct cell* a)
 	}
 
 	/* Assume new symbol */
-	all_symbols = make_cons(a, all_symbols);
+	add_symbol(a);
 	return a;
 }
 
+/****************************************************************
+ *     Wrap the next expression in (QUOTE ...) or the like.     *
+ ****************************************************************/
+struct cell* read_quoted(struct cell* quote_sym)
+{
+	struct cell* r = readobj();
+	push_cell(r);
+	r = make_cons(quote_sym, make_cons(r, nil));
+	pop_cell();
+	return r;
+}
+
 /****************************************************************
  *     "Read an expression from a sequence of tokens."          *
  ****************************************************************/
@@ -295,7 +319,10 @@ struct cell* readlist()
 	}
 
 	struct cell* tmp = readobj();
-	return make_cons(tmp,readlist());
+	push_cell(tmp);
+	tmp = make_cons(tmp,readlist());
+	pop_cell();
+	return tmp;
 }
 
 /****************************************************
@@ -309,6 +336,7 @@ struct cell* reverse_list(struct cell* head)
 	{
 		next = head->cdr;
 		head->cdr = root;
+		gc_write_barrier(head);
 		root = head;
 		head = next;
 	}
@@ -320,6 +348,7 @@ struct cell* reverse_list(struct cell* head)
  ****************************************************/
 struct cell* parse(char* program, int size)
 {
+	token_stack = NULL;
 	token_stack = tokenize(NULL, program, size);
 	if(NULL == token_stack)
 	{
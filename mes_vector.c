@@ -25,6 +25,8 @@
 struct cell* make_int(int a);
 struct cell* make_vector(int count, struct cell* init);
 struct cell* equal(struct cell* a, struct cell* b);
+struct cell* pop_cell();
+void push_cell(struct cell* a);
 
 struct cell* vector_to_list(struct cell* a)
 {
@@ -61,6 +63,7 @@ struct cell* vector_set(struct cell* v, int i, struct cell* e)
 		i = i - 1;
 	}
 	v->car = e;
+	gc_write_barrier(v);
 	return cell_unspecified;
 }
 
@@ -70,7 +73,9 @@ struct cell* list_to_vector(struct cell* i)
 
 	require(CONS == i->type, "mes_vector.c: list_to_vector did not recieve a list\n");
 
+	push_cell(i);
 	struct cell* r = make_vector(0, cell_unspecified);
+	pop_cell();
 	r->cdr = i;
 	int count = 1;
 	while(nil != i->cdr)
@@ -139,25 +144,18 @@ struct cell* builtin_vector_length(struct cell* args)
 	return make_int(args->car->value);
 }
 
-struct cell* builtin_vector_ref(struct cell* args)
+struct cell* builtin_vector_ref(struct cell* v, struct cell* i)
 {
-	require(nil != args, "vector-ref requires an argument\n");
-	require(nil != args->cdr, "vector-ref requires an argument\n");
-	require(nil == args->cdr->cdr, "vector-ref received too many arguments\n");
-	require(VECTOR == args->car->type, "vector-ref did not receive vector\n");
-	require(INT == args->cdr->car->type, "vector-ref did not receive index\n");
-	return vector_ref(args->car, args->cdr->car->value);
+	require(VECTOR == v->type, "vector-ref did not receive vector\n");
+	require(INT == i->type, "vector-ref did not receive index\n");
+	return vector_ref(v, i->value);
 }
 
-struct cell* builtin_vector_set(struct cell* args)
+struct cell* builtin_vector_set(struct cell* v, struct cell* i, struct cell* x)
 {
-	require(nil != args, "vector-set! requires an argument\n");
-	require(nil != args->cdr, "vector-set! requires a second argument\n");
-	require(nil != args->cdr->cdr, "vector-set! requires a third argument\n");
-	require(nil == args->cdr->cdr->cdr, "vector-set! recieved too many argument\n");
-	require(VECTOR == args->car->type, "vector-set! did not receive a vector\n");
-	require(INT == args->cdr->car->type, "vector-set! did not receive an index\n");
-	return vector_set(args->car, args->cdr->car->value, args->cdr->cdr->car);
+	require(VECTOR == v->type, "vector-set! did not receive a vector\n");
+	require(INT == i->type, "vector-set! did not receive an index\n");
+	return vector_set(v, i->value, x);
 }
 
 struct cell* builtin_vector_to_list(struct cell* args)
@@ -0,0 +1,47 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test069.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that old cells pointing into the nursery survive minor collections
+
+(define (wnl x) (write x) (newline))
+(define (junk n) (if (= n 0) 0 (begin (cons n n) (junk (- n 1)))))
+
+(define p (cons 1 2))
+(define v (make-vector 3 0))
+(define x 0)
+(define (f) (define y (list 1 2)) y)
+(junk 500)
+
+(set-car! p (list 10 20 30))
+(set-cdr! p (list 40 50))
+(vector-set! v 1 (list 7 8 9))
+(set! x (list 4 5 6))
+(junk 500)
+(junk 500)
+
+(wnl p)
+(wnl v)
+(wnl x)
+(wnl (f))
+(junk 500)
+(wnl (f))
+
+(exit 0)
@@ -0,0 +1,36 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test070.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that core:gc-stats returns an alist of integers
+
+(define (keys l)
+  (if (null? l)
+      #t
+      (begin
+        (display (car (car l)))
+        (display " ")
+        (display (number? (cdr (car l))))
+        (newline)
+        (keys (cdr l)))))
+
+(keys (core:gc-stats))
+
+(exit 0)
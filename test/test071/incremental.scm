@@ -0,0 +1,53 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test071.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that cells moved behind the back of an incremental mark survive
+
+(define (wnl x) (write x) (newline))
+(define (junk n) (if (= n 0) 0 (begin (cons n n) (junk (- n 1)))))
+
+(define a (make-vector 8 0))
+(define b (make-vector 8 0))
+(define (fill v n) (if (= n 0) 0 (begin (vector-set! v (- n 1) (list n n n)) (fill v (- n 1)))))
+(define (move from to n)
+  (if (= n 0) 0
+      (begin
+        (vector-set! to (- n 1) (vector-ref from (- n 1)))
+        (vector-set! from (- n 1) 0)
+        (junk 5)
+        (move from to (- n 1)))))
+
+(fill a 8)
+(junk 300)
+(begin (junk 100) (move a b 8))
+(junk 300)
+(begin (junk 200) (move b a 8))
+(junk 300)
+(begin (junk 300) (move a b 8))
+(junk 300)
+(begin (junk 400) (move b a 8))
+(junk 300)
+(begin (junk 500) (move a b 8))
+(junk 300)
+(wnl a)
+(wnl b)
+
+(exit 0)
@@ -0,0 +1,41 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test072.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that core:heap-histogram counts the live cells of each type
+
+(define (assq i l) (cond ((null? l) #f) ((eq? i (car (car l))) (car l)) (else (assq i (cdr l)))))
+(define (count type)
+  (define r (assq type (core:heap-histogram)))
+  (if r (cdr r) 0))
+
+(display (number? (count 'cons)))
+(newline)
+(display (< 0 (count 'primop)))
+(newline)
+(define before (count 'vector))
+(define v (list (make-vector 3 0) (make-vector 2 1)))
+(display (- (count 'vector) before))
+(newline)
+(set! v #f)
+(display (- (count 'vector) before))
+(newline)
+
+(exit 0)
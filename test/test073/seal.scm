@@ -0,0 +1,51 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test073.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that mortal cells only an immortal one points to survive
+
+(define (wnl x) (write x) (newline))
+(define (junk n) (if (= n 0) 0 (begin (cons n n) (junk (- n 1)))))
+(define (immortal) (cdr (car (core:gc-stats))))
+(define (fill v n) (if (= n 0) 0 (begin (vector-set! v (- n 1) (list n n n)) (fill v (- n 1)))))
+
+(define a (make-vector 8 0))
+(define b (list 1 2 3))
+(define before (immortal))
+(core:seal-heap)
+(junk 300)
+(wnl (< before (immortal)))
+
+(fill a 8)
+(set-car! b (list 4 5 6))
+(set-cdr! b (list 7 8))
+(define c (list 9 10))
+(junk 300)
+(junk 300)
+(core:seal-heap)
+(junk 300)
+(set-car! c (list 11 12))
+(junk 300)
+(junk 300)
+(wnl a)
+(wnl b)
+(wnl c)
+
+(exit 0)
@@ -0,0 +1,39 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test074.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that reading, expanding and evaluating keep everything they are
+;;; working on safe when every single allocation collects
+
+(define (wnl x) (write x) (newline))
+(define-macro (swap a b) (list 'list b a))
+(define (square-all l) (if (null? l) l (cons (* (car l) (car l)) (square-all (cdr l)))))
+(define (make-counter n) (lambda () (set! n (+ n 1)) n))
+(define c (make-counter 40))
+
+(wnl '(a (b "c" #\d) #(1 2 3) . e))
+(wnl `(1 ,(+ 1 1) ,@(list 3 4)))
+(wnl (swap (list 1 2) (cons 3 4)))
+(wnl (let ((x (list 5 6)) (y (list->vector (list 7 8)))) (list y x)))
+(c)
+(wnl (c))
+(wnl (square-all (list 1 2 3 4)))
+
+(exit 0)
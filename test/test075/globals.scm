@@ -0,0 +1,44 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test075.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that lookups through the sealed environment see later changes
+
+(define (wnl x) (write x) (newline))
+(define (junk n) (if (= n 0) 0 (begin (cons n n) (junk (- n 1)))))
+(define g 1)
+(define (get-g) g)
+(define (twice x) (* 2 x))
+(core:seal-heap)
+(junk 300)
+
+(set! g 2)
+(wnl (get-g))
+(wnl (let ((car cdr)) (car (list 1 2))))
+(wnl ((lambda (cons) (cons 3)) twice))
+(define (twice x) (* 3 x))
+(wnl (twice 2))
+(define-macro (swap a b) (list b a))
+(wnl (swap 4 twice))
+(define + -)
+(wnl (+ 5 1))
+(wnl (list (get-g) (twice 1)))
+
+(exit 0)
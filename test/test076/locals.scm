@@ -0,0 +1,42 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test076.answer"))
+(define (newline) (display #\newline))
+
+;;; Test binding locals from the list of evaluated arguments
+
+(define (wnl x) (write x) (newline))
+(define (swap a b) (list b a))
+(define (rest a . more) (cons more a))
+(define (counter n) (lambda () (set! n (+ n 1)) n))
+(define (pick x x) x)
+
+(define args (list 1 2))
+(wnl (apply swap args))
+(wnl args)
+(wnl (rest 1 2 3))
+(wnl (rest 1))
+(define c (counter 10))
+(c)
+(wnl (c))
+(wnl (pick 1 2))
+(wnl '())
+(wnl (null? '()))
+
+(exit 0)
@@ -0,0 +1,44 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test077.answer"))
+(define (newline) (display #\newline))
+
+;;; Test interned symbols and the hashed global environment
+
+(define (wnl x) (write x) (newline))
+(define (later) (forward 20))
+(wnl (eq? 'foo (list->symbol (list #\f #\o #\o))))
+(wnl (eq? 'bar (string->symbol "bar")))
+(wnl (eq? 'baz (keyword->symbol #:baz)))
+(define forward (lambda (n) (+ n 1)))
+(wnl (later))
+(define forward (lambda (n) (* n 2)))
+(wnl (later))
+(define x 1)
+(define (get-x) x)
+(let ((x 2)) (wnl (list x (get-x))))
+(define x 3)
+(wnl (get-x))
+(define-macro (twice e) (list 'begin e e))
+(define n 0)
+(twice (set! n (+ n 1)))
+(wnl n)
+(wnl (later))
+
+(exit 0)
@@ -0,0 +1,38 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test078.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that there is only ever one symbol of a given name
+
+(define (wnl x) (write x) (newline))
+(define s (list->string (list #\q #\q)))
+(define y (string->symbol s))
+(string-set! s 0 #\z)
+(wnl y)
+(wnl (eq? y 'qq))
+(wnl (eq? y (string->symbol "qq")))
+(wnl (eq? (string->symbol "zq") (list->symbol (list #\z #\q))))
+(wnl (eq? (keyword->symbol #:qq) y))
+(define s1 1)
+(define s2 2)
+(define s3 3)
+(wnl (list s1 s2 s3 (eq? 's2 (string->symbol "s2"))))
+
+(exit 0)
@@ -0,0 +1,50 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test079.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that tail calls run in constant space, as hello.sh only
+;;; gives us a small MES_STACK
+
+(define (wnl x) (write x) (newline))
+(define (count n acc) (if (= n 0) acc (count (- n 1) (+ acc 1))))
+(wnl (count 20000 0))
+(define (down n) (cond ((= n 0) 'cond) (#t (down (- n 1)))))
+(wnl (down 20000))
+(define (pick n) (case n ((0) 'case) (else (pick (- n 1)))))
+(wnl (pick 20000))
+(define (both n) (and #t (or #f (if (= n 0) 'and-or (both (- n 1))))))
+(wnl (both 20000))
+(define (body n) (when #t (begin 1 (let ((m (- n 1))) (if (< m 0) 'let (body m))))))
+(wnl (body 20000))
+(define (even2? n) (if (= n 0) #t (odd2? (- n 1))))
+(define (odd2? n) (if (= n 0) #f (even2? (- n 1))))
+(wnl (even2? 20001))
+
+;; The locals of a let do not outlive it
+(define x 5)
+(define (f y) (let ((x 1)) x) (list x y))
+(wnl (f 0))
+
+;; Nor do those of a tail call
+(define (g a) (if (= a 0) 'done (g (- a 1))))
+(define (h a) (g 3) a)
+(wnl (h 7))
+
+(exit 0)
@@ -0,0 +1,53 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test080.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that running a body allocates nothing, by counting the cells
+;;; allocated around it against those allocated around a constant
+
+(define (wnl x) (write x) (newline))
+(define (find k l) (if (eq? k (car (car l))) (cdr (car l)) (find k (cdr l))))
+(define (allocated) (find 'cells-allocated (core:gc-stats)))
+
+;; The first call interns the names of the stats
+(allocated)
+
+(define (nothing) (let ((a (allocated))) 1 (- (allocated) a)))
+(define (in-cond) (let ((a (allocated))) (cond (#f 0) (#t 1 2)) (- (allocated) a)))
+(define (in-case) (let ((a (allocated))) (case 3 ((1 2) 0) ((3) 1 2)) (- (allocated) a)))
+(define (in-begin) (let ((a (allocated))) (begin 1 2) (- (allocated) a)))
+(define flag #t)
+(define (in-while) (let ((a (allocated))) (while flag (set! flag #f) 2) (- (allocated) a)))
+(define (same f) (let ((n (nothing))) (- (f) n)))
+(wnl (list (same in-cond) (same in-case) (same in-begin) (same in-while)))
+
+;; Calls are counted too
+(define (find-applications) (find 'applications (core:gc-stats)))
+(define calls (find-applications))
+(define (id x) x)
+(id (id 1))
+(wnl (< calls (find-applications)))
+
+;; Bodies still give the value of their last expression
+(wnl (list (cond (#t 1 2)) (case 1 ((1) 3 4)) (let ((x 5)) x 6)))
+(define (w n) (while (> n 0) (set! n (- n 1)) n))
+(wnl (w 3))
+
+(exit 0)
@@ -0,0 +1,37 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test081.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that special forms are found by the syntax id of their symbol
+
+(define (wnl x) (write x) (newline))
+(wnl (primitive-eval (list (string->symbol "if") #f 1 2)))
+(wnl (primitive-eval (list (keyword->symbol #:quote) 'x)))
+(wnl (primitive-eval (list (list->symbol (list #\b #\e #\g #\i #\n)) 1 2 3)))
+(wnl ((lambda (x) (* x x)) 3))
+(define (iff a b) (list a b))
+(wnl (iff 1 2))
+(define (f let) (+ let 1))
+(wnl (f 4))
+(wnl (let ((x 1)) (cond ((= x 2) 'two) (else (case x ((1) (when #t (and 1 (or #f 'one)))))))))
+(define n 3)
+(wnl (begin (while (< 0 n) (set! n (- n 1))) `(n ,n)))
+
+(exit 0)
@@ -0,0 +1,53 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test082.answer"))
+(define (newline) (display #\newline))
+
+;;; Test that primitives of fixed arity are called without consing
+;;; a list of their arguments, and still work through apply
+
+(define (wnl x) (write x) (newline))
+(define (find k l) (if (eq? k (car (car l))) (cdr (car l)) (find k (cdr l))))
+(define (allocated) (find 'cells-allocated (core:gc-stats)))
+
+;; The first call interns the names of the stats
+(allocated)
+
+(define p (cons 1 2))
+(define v (make-vector 2 0))
+(define (nothing) (let ((a (allocated))) 1 (- (allocated) a)))
+(define (in-pairs) (let ((a (allocated))) (car p) (cdr p) (null? p) (pair? p) (not p) (set-car! p 3) (set-cdr! p 4) (- (allocated) a)))
+(define (in-vectors) (let ((a (allocated))) (vector-ref v 0) (vector-set! v 1 p) (- (allocated) a)))
+(define (in-compares) (let ((a (allocated))) (eq? p p) (= 1 1) (< 1 2) (> 1 2) (- (allocated) a)))
+(define (in-cons) (let ((a (allocated))) (cons p p) (- (allocated) a)))
+(define (same f) (let ((n (nothing))) (- (f) n)))
+(wnl (list (same in-pairs) (same in-vectors) (same in-compares) (same in-cons)))
+(wnl (list p (car (cdr (cons 1 (cons 2 3)))) (vector-ref v 1)))
+
+;; Other numbers of arguments still take the list
+(wnl (list (+ 1 2) (+ 1 2 3) (+) (- 10 3) (- 10 3 2) (* 2 3) (* 2 3 4)))
+(wnl (list (= 1 1) (= 1 1 2) (< 1 2) (< 1 2 2) (> 2 1) (> 3 2 1) (eq? 'a 'a) (eq? 'a 'a 'b) (eq? 1 1)))
+
+;; As does apply, which spreads it over the arguments
+(define (map f l) (if (null? l) l (cons (f (car l)) (map f (cdr l)))))
+(wnl (list (apply car '((1 2))) (apply cons '(1 2)) (map car '((1) (2))) (apply + '(1 2))))
+(apply vector-set! (list v 0 'x))
+(wnl v)
+
+(exit 0)
@@ -0,0 +1,31 @@
+;;; GNU Mes --- Maxwell Equations of Software
+;;;
+;;; This file is part of GNU Mes.
+;;;
+;;; GNU Mes is free software; you can redistribute it and/or modify it
+;;; under the terms of the GNU General Public License as published by
+;;; the Free Software Foundation; either version 3 of the License, or (at
+;;; your option) any later version.
+;;;
+;;; GNU Mes is distributed in the hope that it will be useful, but
+;;; WITHOUT ANY WARRANTY; without even the implied warranty of
+;;; MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+;;; GNU General Public License for more details.
+;;;
+;;; You should have received a copy of the GNU General Public License
+;;; along with GNU Mes.  If not, see <http://www.gnu.org/licenses/>
+
+;; Setup output file
+(set-current-output-port (open-output-file "test/results/test083.answer"))
+(define (newline) (display #\newline))
+
+;;; Test growing a pool whose reservation does not fit in 32 bits
+
+(define (build n acc) (if (= n 0) acc (build (- n 1) (cons n acc))))
+(define l (build 200000 '()))
+(display (car l))
+(newline)
+(display (length l))
+(newline)
+
+(exit 0)